@@ -14,8 +14,9 @@ constexpr auto COMPUTE_SHADER_IMAGE_FORMAT = DXGI_FORMAT_R8G8B8A8_UNORM;
 constexpr auto COMPUTE_SHADER_KC_CENTROID_INIT_FULL_RANDOM = FALSE;
 constexpr auto COMPUTE_SHADER_KC_CENTROID_INIT_NO_RANDOM = FALSE;
 constexpr auto COMPUTE_SHADER_KC_CENTROID_INIT_FROM_PIXEL_SET = TRUE;
-constexpr auto COMPUTE_SHADER_KC_CENTROID_COUNT = 32;
+constexpr auto COMPUTE_SHADER_KC_CENTROID_COUNT = 32;								//Default, the renderers take the centroid count at construction
 constexpr auto COMPUTE_SHADER_KC_LOOP_COUNT = 20;
+constexpr auto COMPUTE_SHADER_KC_CONVERGENCE_CENTROID_SHIFT = 0.001f;				//Max centroid move in [0, 1] channels, 0 - off
 
 
 constexpr BYTE CQRENDER_ONUPDATE_NO_FLAG				= 0b00000000;
@@ -33,3 +34,26 @@ constexpr auto CUBELIGHTINGRENDER_DEPTH_STENCIL_BUFFER_FORMAT = DXGI_FORMAT_D32_
 
 constexpr auto CLUSTERING_ITERATIONS_DEPTH_STENCIL_BUFFER_FORMAT = DXGI_FORMAT_D32_FLOAT;
 constexpr auto CLUSTERING_ITERATIONS_ORIGINAL_VIDEO_FRAME_FORMAT = DXGI_FORMAT_R8G8B8A8_UNORM;
+constexpr auto CLUSTERING_ITERATIONS_KMEANS_HAMERLY = FALSE;
+constexpr auto CLUSTERING_ITERATIONS_KMEANS_KD_TREE_CENTROID_COUNT = 256;		//k-d tree search from this palette size
+constexpr auto CLUSTERING_ITERATIONS_KMEANS_FIXED_POINT = TRUE;					//Integer distances on the packed pixel bytes
+constexpr auto CLUSTERING_ITERATIONS_COLOR_SPACE = 0;						//0 - RGB, 1 - OKLab, 2 - CIELAB
+constexpr auto CLUSTERING_ITERATIONS_HISTOGRAM_BIN_BITS = 6;					//0 - exact color histogram
+constexpr auto CLUSTERING_ITERATIONS_SEEDING_METHOD = 1;						//0 - uniform, 1 - k-means++, 2 - k-means||, 3 - median cut
+constexpr auto CLUSTERING_ITERATIONS_TEMPORAL_WARM_START = TRUE;				//Start a frame from the centroids of the previous one
+constexpr auto CLUSTERING_ITERATIONS_SCENE_CUT_BIN_BITS = 4;
+constexpr auto CLUSTERING_ITERATIONS_SCENE_CUT_DISTANCE = 0.25f;					//Color distribution distance of a scene cut, [0, 1]
+constexpr auto CLUSTERING_ITERATIONS_MINI_BATCH = FALSE;						//Iterate on pixel batches instead of the histogram, for 4K and 8K video
+constexpr auto CLUSTERING_ITERATIONS_MINI_BATCH_SIZE = 4096;
+constexpr auto CLUSTERING_ITERATIONS_MINI_BATCH_COUNT = 16;					//Batches per iteration
+constexpr auto CLUSTERING_ITERATIONS_MINI_BATCH_SAMPLING = 0;					//0 - random, 1 - strided
+constexpr auto CLUSTERING_ITERATIONS_MINI_BATCH_MIN_LEARNING_RATE = 0.0f;
+constexpr auto CLUSTERING_ITERATIONS_ADAPTIVE_PALETTE = FALSE;					//Palette size picked per frame from an error budget, the centroid count is the max
+constexpr auto CLUSTERING_ITERATIONS_ADAPTIVE_PALETTE_MIN_CENTROID_COUNT = 4;
+constexpr auto CLUSTERING_ITERATIONS_ADAPTIVE_PALETTE_TARGET_PSNR = 32.0f;		//dB of the quantized frame, in the clustering color space
+constexpr auto CLUSTERING_ITERATIONS_MAX_ITERATION_COUNT = 20;
+constexpr auto CLUSTERING_ITERATIONS_CONVERGENCE_CENTROID_SHIFT = 0.001f;			//Max centroid move in [0, 1] channels, 0 - off
+constexpr auto CLUSTERING_ITERATIONS_CONVERGENCE_REASSIGNED_RATIO = 0.001f;		//Fraction of pixels changing cluster, 0 - off
+constexpr auto CLUSTERING_ITERATIONS_CONVERGENCE_INERTIA_DELTA = 0.0001f;			//Relative inertia drop, 0 - off
+constexpr auto CLUSTERING_ITERATIONS_INCREMENTAL_VORONOI = TRUE;				//Update the voronoi diagram where centroids moved instead of building it again
+constexpr auto CLUSTERING_ITERATIONS_VORONOI_TRIANGLE_CAPACITY = 10000;			//Initial voronoi vertex buffer size, it grows with the diagram
@@ -0,0 +1,199 @@
+#include <centroid_kd_tree.h>
+
+#include <algorithm>
+
+namespace VoronoiCore {
+
+namespace {
+
+const uint32_t LEAF_AXIS = 3;
+
+//Centroids per leaf - a leaf is searched linearly, cheaper than descending further
+const uint32_t LEAF_SIZE = 8;
+
+//Deepest path of a tree over 2^32 centroids is far below this
+const uint32_t SEARCH_STACK_SIZE = 64;
+
+//Squared distance slack before a split plane prunes a subtree - far above the float rounding of squared
+//distances in [0, 255] space, so no subtree holding an equally close centroid is ever skipped
+const float PRUNE_MARGIN = 0.5f;
+
+}
+
+CentroidKdTree::CentroidKdTree() {}
+
+CentroidKdTree::~CentroidKdTree() {}
+
+void CentroidKdTree::Build(const CentroidTable& centroids) {
+
+	m_tableR.assign(centroids.r, centroids.r + centroids.count);
+	m_tableG.assign(centroids.g, centroids.g + centroids.count);
+	m_tableB.assign(centroids.b, centroids.b + centroids.count);
+
+	m_centroidIndices.resize(centroids.count);
+	for (uint32_t i = 0; i < centroids.count; ++i) m_centroidIndices[i] = i;
+
+	m_nodes.clear();
+	if (centroids.count != 0) BuildNode(0, centroids.count);
+
+	m_centroidR.resize(centroids.count);
+	m_centroidG.resize(centroids.count);
+	m_centroidB.resize(centroids.count);
+	for (uint32_t i = 0; i < centroids.count; ++i) {
+
+		m_centroidR[i] = m_tableR[m_centroidIndices[i]];
+		m_centroidG[i] = m_tableG[m_centroidIndices[i]];
+		m_centroidB[i] = m_tableB[m_centroidIndices[i]];
+
+	}
+
+}
+
+void CentroidKdTree::Assign(const uint32_t* pixels, size_t pixelCount, uint32_t* assignments) const {
+
+	if (m_nodes.empty()) return;
+
+	const float* tables[3] = { m_tableR.data(), m_tableG.data(), m_tableB.data() };
+
+	uint32_t stackNodes[SEARCH_STACK_SIZE];
+	float stackOffsets[SEARCH_STACK_SIZE][3];
+	float stackDistances[SEARCH_STACK_SIZE];
+	uint32_t previousAssignment = 0;
+
+	for (size_t i = 0; i < pixelCount; ++i) {
+
+		float color[3] = {
+			static_cast<float>((pixels[i] >> 16) & 0xFF),
+			static_cast<float>((pixels[i] >> 8) & 0xFF),
+			static_cast<float>(pixels[i] & 0xFF)
+		};
+
+		//The previous pixel's centroid is usually the closest one or close to it, a tight start prunes most of the tree
+		float distanceR = tables[0][previousAssignment] - color[0];
+		float distanceG = tables[1][previousAssignment] - color[1];
+		float distanceB = tables[2][previousAssignment] - color[2];
+		float minDistance = distanceR * distanceR + distanceG * distanceG + distanceB * distanceB;
+		uint32_t minDistanceIndex = previousAssignment;
+
+		//Every stacked subtree keeps the per channel offsets from the color to its cell, their squared sum bounds
+		//the distance to any centroid inside it
+		uint32_t stackSize = 1;
+		stackNodes[0] = 0;
+		stackOffsets[0][0] = 0.0f;
+		stackOffsets[0][1] = 0.0f;
+		stackOffsets[0][2] = 0.0f;
+		stackDistances[0] = 0.0f;
+
+		while (stackSize != 0) {
+
+			stackSize--;
+			if (stackDistances[stackSize] > minDistance + PRUNE_MARGIN) continue;
+
+			uint32_t nodeIndex = stackNodes[stackSize];
+			float offsets[3] = { stackOffsets[stackSize][0], stackOffsets[stackSize][1], stackOffsets[stackSize][2] };
+			float cellDistance = stackDistances[stackSize];
+
+			//Walk down to a leaf, keeping the far sides for later
+			while (m_nodes[nodeIndex].axis != LEAF_AXIS) {
+
+				const Node& node = m_nodes[nodeIndex];
+				float planeDistance = color[node.axis] - node.split;
+				uint32_t nearChild = planeDistance < 0.0f ? nodeIndex + 1 : node.right;
+				uint32_t farChild = planeDistance < 0.0f ? node.right : nodeIndex + 1;
+
+				float farDistance = cellDistance - offsets[node.axis] * offsets[node.axis] + planeDistance * planeDistance;
+				if (farDistance <= minDistance + PRUNE_MARGIN) {
+
+					stackNodes[stackSize] = farChild;
+					stackOffsets[stackSize][0] = offsets[0];
+					stackOffsets[stackSize][1] = offsets[1];
+					stackOffsets[stackSize][2] = offsets[2];
+					stackOffsets[stackSize][node.axis] = planeDistance;
+					stackDistances[stackSize] = farDistance;
+					stackSize++;
+
+				}
+
+				nodeIndex = nearChild;
+
+			}
+
+			const Node& leaf = m_nodes[nodeIndex];
+			for (uint32_t j = leaf.first; j < leaf.first + leaf.count; ++j) {
+
+				distanceR = m_centroidR[j] - color[0];
+				distanceG = m_centroidG[j] - color[1];
+				distanceB = m_centroidB[j] - color[2];
+				float distance = distanceR * distanceR + distanceG * distanceG + distanceB * distanceB;
+
+				//Same tie break as the brute force search - the lower index wins between equal distances
+				if (distance < minDistance || (distance == minDistance && m_centroidIndices[j] < minDistanceIndex)) {
+
+					minDistance = distance;
+					minDistanceIndex = m_centroidIndices[j];
+
+				}
+
+			}
+
+		}
+
+		assignments[i] = minDistanceIndex;
+		previousAssignment = minDistanceIndex;
+
+	}
+
+}
+
+//Split the centroids [first, first + count) at the median of their widest channel
+uint32_t CentroidKdTree::BuildNode(uint32_t first, uint32_t count) {
+
+	uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+	m_nodes.push_back({ LEAF_AXIS, 0.0f, 0, first, count });
+
+	if (count <= LEAF_SIZE) return nodeIndex;
+
+	const float* tables[3] = { m_tableR.data(), m_tableG.data(), m_tableB.data() };
+
+	uint32_t axis = 0;
+	float maxSpread = -1.0f;
+	for (uint32_t a = 0; a < 3; ++a) {
+
+		float minValue = tables[a][m_centroidIndices[first]];
+		float maxValue = minValue;
+		for (uint32_t i = first + 1; i < first + count; ++i) {
+
+			minValue = std::min(minValue, tables[a][m_centroidIndices[i]]);
+			maxValue = std::max(maxValue, tables[a][m_centroidIndices[i]]);
+
+		}
+
+		if (maxValue - minValue > maxSpread) {
+
+			maxSpread = maxValue - minValue;
+			axis = a;
+
+		}
+
+	}
+
+	const float* table = tables[axis];
+	uint32_t middle = first + count / 2;
+	std::nth_element(m_centroidIndices.begin() + first, m_centroidIndices.begin() + middle, m_centroidIndices.begin() + first + count,
+		[table](uint32_t a, uint32_t b) { return table[a] < table[b]; });
+
+	//Left holds values <= split, right values >= split - searches pick a side by the split and prune by plane distance
+	float split = table[m_centroidIndices[middle]];
+
+	BuildNode(first, middle - first);
+	uint32_t right = BuildNode(middle, first + count - middle);
+
+	m_nodes[nodeIndex].axis = axis;
+	m_nodes[nodeIndex].split = split;
+	m_nodes[nodeIndex].right = right;
+
+	return nodeIndex;
+
+}
+
+}
@@ -0,0 +1,227 @@
+#include <color_histogram.h>
+
+namespace VoronoiCore {
+
+namespace {
+
+const uint32_t EMPTY_SLOT = 0xFFFFFFFF;
+
+//Smallest exact table - twice the distinct color bound keeps the probe chains short
+const size_t MIN_EXACT_TABLE_SIZE = 1024;
+
+}
+
+ColorHistogram::ColorHistogram() : m_squaredNormSum(0) {}
+
+ColorHistogram::~ColorHistogram() {}
+
+void ColorHistogram::Build(const uint32_t* pixels, size_t pixelCount, uint32_t binBits) {
+
+	Clear();
+	m_pixelEntries.resize(pixelCount);
+
+	if (binBits == 0 || binBits >= 8) {
+
+		//A frame holds at most min(pixelCount, 2^24) distinct colors
+		size_t maxColorCount = pixelCount < (size_t(1) << 24) ? pixelCount : (size_t(1) << 24);
+		size_t tableSize = MIN_EXACT_TABLE_SIZE;
+		uint32_t tableBits = 10;
+		while (tableSize < 2 * maxColorCount) {
+
+			tableSize <<= 1;
+			tableBits++;
+
+		}
+
+		m_tableKeys.assign(tableSize, EMPTY_SLOT);
+		m_tableEntries.resize(tableSize);
+
+		//Runs of identical pixels are common in video, they skip the table lookup
+		uint32_t previousKey = EMPTY_SLOT;
+		uint32_t previousEntry = 0;
+
+		for (size_t i = 0; i < pixelCount; ++i) {
+
+			uint32_t key = pixels[i] & 0xFFFFFF;
+			uint32_t entry = previousEntry;
+
+			if (key != previousKey) {
+
+				size_t slot = static_cast<size_t>((key * 2654435761u) >> (32 - tableBits));
+				while (m_tableKeys[slot] != key && m_tableKeys[slot] != EMPTY_SLOT) slot = (slot + 1) & (tableSize - 1);
+
+				if (m_tableKeys[slot] == EMPTY_SLOT) {
+
+					m_tableKeys[slot] = key;
+					m_tableEntries[slot] = AddEntry(key);
+
+				}
+
+				entry = m_tableEntries[slot];
+				previousKey = key;
+				previousEntry = entry;
+
+			}
+
+			uint32_t colorR = (key >> 16) & 0xFF;
+			uint32_t colorG = (key >> 8) & 0xFF;
+			uint32_t colorB = key & 0xFF;
+
+			m_pixelEntries[i] = entry;
+			m_entrySumsR[entry] += colorR;
+			m_entrySumsG[entry] += colorG;
+			m_entrySumsB[entry] += colorB;
+			m_entryCounts[entry] += 1;
+			m_squaredNormSum += colorR * colorR + colorG * colorG + colorB * colorB;
+
+		}
+
+	}
+	else {
+
+		uint32_t shift = 8 - binBits;
+		m_tableEntries.assign(size_t(1) << (3 * binBits), EMPTY_SLOT);
+
+		for (size_t i = 0; i < pixelCount; ++i) {
+
+			uint32_t colorR = (pixels[i] >> 16) & 0xFF;
+			uint32_t colorG = (pixels[i] >> 8) & 0xFF;
+			uint32_t colorB = pixels[i] & 0xFF;
+
+			uint32_t bin = ((colorR >> shift) << (2 * binBits)) | ((colorG >> shift) << binBits) | (colorB >> shift);
+			if (m_tableEntries[bin] == EMPTY_SLOT) m_tableEntries[bin] = AddEntry(0);
+
+			uint32_t entry = m_tableEntries[bin];
+			m_pixelEntries[i] = entry;
+			m_entrySumsR[entry] += colorR;
+			m_entrySumsG[entry] += colorG;
+			m_entrySumsB[entry] += colorB;
+			m_entryCounts[entry] += 1;
+			m_squaredNormSum += colorR * colorR + colorG * colorG + colorB * colorB;
+
+		}
+
+	}
+
+	FinishEntries();
+
+}
+
+void ColorHistogram::ConvertColors(const ColorSpaceConverter& converter) {
+
+	if (converter.GetColorSpace() == COLOR_SPACE_RGB) return;
+
+	m_squaredNormSum = 0;
+
+	for (size_t i = 0; i < m_entryColors.size(); ++i) {
+
+		uint32_t color = converter.EncodePixel(m_entryColors[i]);
+		uint64_t colorR = (color >> 16) & 0xFF;
+		uint64_t colorG = (color >> 8) & 0xFF;
+		uint64_t colorB = color & 0xFF;
+		uint64_t count = m_entryCounts[i];
+
+		m_entryColors[i] = color;
+		m_entrySumsR[i] = colorR * count;
+		m_entrySumsG[i] = colorG * count;
+		m_entrySumsB[i] = colorB * count;
+		m_squaredNormSum += (colorR * colorR + colorG * colorG + colorB * colorB) * count;
+
+	}
+
+}
+
+size_t ColorHistogram::GetEntryCount() const {
+
+	return m_entryColors.size();
+
+}
+
+size_t ColorHistogram::GetPixelCount() const {
+
+	return m_pixelEntries.size();
+
+}
+
+uint64_t ColorHistogram::GetSquaredNormSum() const {
+
+	return m_squaredNormSum;
+
+}
+
+const uint32_t* ColorHistogram::GetEntryColors() const {
+
+	return m_entryColors.data();
+
+}
+
+const uint64_t* ColorHistogram::GetEntrySumsR() const {
+
+	return m_entrySumsR.data();
+
+}
+
+const uint64_t* ColorHistogram::GetEntrySumsG() const {
+
+	return m_entrySumsG.data();
+
+}
+
+const uint64_t* ColorHistogram::GetEntrySumsB() const {
+
+	return m_entrySumsB.data();
+
+}
+
+const uint32_t* ColorHistogram::GetEntryCounts() const {
+
+	return m_entryCounts.data();
+
+}
+
+const uint32_t* ColorHistogram::GetPixelEntries() const {
+
+	return m_pixelEntries.data();
+
+}
+
+void ColorHistogram::Clear() {
+
+	m_entryColors.clear();
+	m_entrySumsR.clear();
+	m_entrySumsG.clear();
+	m_entrySumsB.clear();
+	m_entryCounts.clear();
+	m_squaredNormSum = 0;
+
+}
+
+uint32_t ColorHistogram::AddEntry(uint32_t color) {
+
+	m_entryColors.push_back(color);
+	m_entrySumsR.push_back(0);
+	m_entrySumsG.push_back(0);
+	m_entrySumsB.push_back(0);
+	m_entryCounts.push_back(0);
+
+	return static_cast<uint32_t>(m_entryColors.size() - 1);
+
+}
+
+//Entry colors become the rounded means of their pixels, exact entries keep their color
+void ColorHistogram::FinishEntries() {
+
+	for (size_t i = 0; i < m_entryColors.size(); ++i) {
+
+		uint64_t count = m_entryCounts[i];
+		uint32_t colorR = static_cast<uint32_t>((m_entrySumsR[i] + count / 2) / count);
+		uint32_t colorG = static_cast<uint32_t>((m_entrySumsG[i] + count / 2) / count);
+		uint32_t colorB = static_cast<uint32_t>((m_entrySumsB[i] + count / 2) / count);
+
+		m_entryColors[i] = (uint32_t(0xFF) << 24) | (colorR << 16) | (colorG << 8) | colorB;
+
+	}
+
+}
+
+}
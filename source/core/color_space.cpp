@@ -0,0 +1,201 @@
+#include <color_space.h>
+
+#include <cmath>
+
+namespace VoronoiCore {
+
+namespace {
+
+//Root table intervals - linear interpolation keeps the packed channels within half a level of the exact conversion
+//The cube root is too steep near 0 to interpolate, the first intervals are computed
+const uint32_t ROOT_TABLE_SIZE = 4096;
+const float ROOT_EXACT_POSITION = 16.0f;
+
+const float OKLAB_SCALE = 255.0f;
+const float CIELAB_SCALE = 1.1f;
+const float CHROMA_OFFSET = 128.0f;
+
+//D65 white point
+const float WHITE_X = 0.95047f;
+const float WHITE_Y = 1.0f;
+const float WHITE_Z = 1.08883f;
+
+//CIELAB f(t) is linear below (6 / 29)^3
+const float CIELAB_DELTA = 6.0f / 29.0f;
+
+float SrgbToLinear(float value) {
+
+	return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+
+}
+
+float LinearToSrgb(float value) {
+
+	return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+
+}
+
+float CielabF(float value) {
+
+	return value > CIELAB_DELTA * CIELAB_DELTA * CIELAB_DELTA ? std::cbrt(value) : value / (3.0f * CIELAB_DELTA * CIELAB_DELTA) + 4.0f / 29.0f;
+
+}
+
+float CielabInverseF(float value) {
+
+	return value > CIELAB_DELTA ? value * value * value : 3.0f * CIELAB_DELTA * CIELAB_DELTA * (value - 4.0f / 29.0f);
+
+}
+
+uint32_t PackChannel(float value) {
+
+	float rounded = value + 0.5f;
+	if (rounded <= 0.0f) return 0;
+	if (rounded >= 255.0f) return 255;
+
+	return static_cast<uint32_t>(rounded);
+
+}
+
+}
+
+ColorSpaceConverter::ColorSpaceConverter(ColorSpace colorSpace) :
+	m_colorSpace(colorSpace),
+	m_linearTable(256),
+	m_rootTable(ROOT_TABLE_SIZE + 1) {
+
+	for (uint32_t i = 0; i < 256; ++i) m_linearTable[i] = SrgbToLinear(static_cast<float>(i) / 255.0f);
+
+	for (uint32_t i = 0; i <= ROOT_TABLE_SIZE; ++i) {
+
+		float value = static_cast<float>(i) / static_cast<float>(ROOT_TABLE_SIZE);
+		m_rootTable[i] = m_colorSpace == COLOR_SPACE_CIELAB ? CielabF(value) : std::cbrt(value);
+
+	}
+
+}
+
+ColorSpaceConverter::~ColorSpaceConverter() {}
+
+ColorSpace ColorSpaceConverter::GetColorSpace() const {
+
+	return m_colorSpace;
+
+}
+
+uint32_t ColorSpaceConverter::EncodePixel(uint32_t pixel) const {
+
+	if (m_colorSpace == COLOR_SPACE_RGB) return pixel;
+
+	float linearR = m_linearTable[(pixel >> 16) & 0xFF];
+	float linearG = m_linearTable[(pixel >> 8) & 0xFF];
+	float linearB = m_linearTable[pixel & 0xFF];
+
+	float lightness = 0.0f;
+	float chromaA = 0.0f;
+	float chromaB = 0.0f;
+
+	if (m_colorSpace == COLOR_SPACE_OKLAB) {
+
+		float rootL = Root(0.4122214708f * linearR + 0.5363325363f * linearG + 0.0514459929f * linearB);
+		float rootM = Root(0.2119034982f * linearR + 0.6806995451f * linearG + 0.1073969566f * linearB);
+		float rootS = Root(0.0883024619f * linearR + 0.2817188376f * linearG + 0.6299787005f * linearB);
+
+		lightness = (0.2104542553f * rootL + 0.7936177850f * rootM - 0.0040720468f * rootS) * OKLAB_SCALE;
+		chromaA = (1.9779984951f * rootL - 2.4285922050f * rootM + 0.4505937099f * rootS) * OKLAB_SCALE;
+		chromaB = (0.0259040371f * rootL + 0.7827717662f * rootM - 0.8086757660f * rootS) * OKLAB_SCALE;
+
+	}
+	else {
+
+		float rootX = Root((0.4124564f * linearR + 0.3575761f * linearG + 0.1804375f * linearB) / WHITE_X);
+		float rootY = Root((0.2126729f * linearR + 0.7151522f * linearG + 0.0721750f * linearB) / WHITE_Y);
+		float rootZ = Root((0.0193339f * linearR + 0.1191920f * linearG + 0.9503041f * linearB) / WHITE_Z);
+
+		lightness = (116.0f * rootY - 16.0f) * CIELAB_SCALE;
+		chromaA = 500.0f * (rootX - rootY) * CIELAB_SCALE;
+		chromaB = 200.0f * (rootY - rootZ) * CIELAB_SCALE;
+
+	}
+
+	return (uint32_t(0xFF) << 24) | (PackChannel(lightness) << 16) | (PackChannel(chromaA + CHROMA_OFFSET) << 8) | PackChannel(chromaB + CHROMA_OFFSET);
+
+}
+
+void ColorSpaceConverter::EncodePixels(const uint32_t* pixels, size_t pixelCount, uint32_t* encodedPixels) const {
+
+	for (size_t i = 0; i < pixelCount; ++i) encodedPixels[i] = EncodePixel(pixels[i]);
+
+}
+
+//Runs once per centroid, so the exact functions are used instead of the tables
+uint32_t ColorSpaceConverter::DecodeColor(const Point& color) const {
+
+	float linearR = color.x;
+	float linearG = color.y;
+	float linearB = color.z;
+
+	if (m_colorSpace == COLOR_SPACE_RGB) {
+
+		return (uint32_t(0xFF) << 24) | (PackChannel(color.x * 255.0f - 0.5f) << 16) | (PackChannel(color.y * 255.0f - 0.5f) << 8) | PackChannel(color.z * 255.0f - 0.5f);
+
+	}
+
+	if (m_colorSpace == COLOR_SPACE_OKLAB) {
+
+		float lightness = color.x * 255.0f / OKLAB_SCALE;
+		float chromaA = (color.y * 255.0f - CHROMA_OFFSET) / OKLAB_SCALE;
+		float chromaB = (color.z * 255.0f - CHROMA_OFFSET) / OKLAB_SCALE;
+
+		float rootL = lightness + 0.3963377774f * chromaA + 0.2158037573f * chromaB;
+		float rootM = lightness - 0.1055613458f * chromaA - 0.0638541728f * chromaB;
+		float rootS = lightness - 0.0894841775f * chromaA - 1.2914855480f * chromaB;
+		float coneL = rootL * rootL * rootL;
+		float coneM = rootM * rootM * rootM;
+		float coneS = rootS * rootS * rootS;
+
+		linearR = 4.0767416621f * coneL - 3.3077115913f * coneM + 0.2309699292f * coneS;
+		linearG = -1.2684380046f * coneL + 2.6097574011f * coneM - 0.3413193965f * coneS;
+		linearB = -0.0041960863f * coneL - 0.7034186147f * coneM + 1.7076147010f * coneS;
+
+	}
+	else {
+
+		float rootY = (color.x * 255.0f / CIELAB_SCALE + 16.0f) / 116.0f;
+		float rootX = rootY + (color.y * 255.0f - CHROMA_OFFSET) / CIELAB_SCALE / 500.0f;
+		float rootZ = rootY - (color.z * 255.0f - CHROMA_OFFSET) / CIELAB_SCALE / 200.0f;
+		float colorX = WHITE_X * CielabInverseF(rootX);
+		float colorY = WHITE_Y * CielabInverseF(rootY);
+		float colorZ = WHITE_Z * CielabInverseF(rootZ);
+
+		linearR = 3.2404542f * colorX - 1.5371385f * colorY - 0.4985314f * colorZ;
+		linearG = -0.9692660f * colorX + 1.8760108f * colorY + 0.0415560f * colorZ;
+		linearB = 0.0556434f * colorX - 0.2040259f * colorY + 1.0572252f * colorZ;
+
+	}
+
+	linearR = std::fmin(std::fmax(linearR, 0.0f), 1.0f);
+	linearG = std::fmin(std::fmax(linearG, 0.0f), 1.0f);
+	linearB = std::fmin(std::fmax(linearB, 0.0f), 1.0f);
+
+	return (uint32_t(0xFF) << 24) | (PackChannel(LinearToSrgb(linearR) * 255.0f) << 16) | (PackChannel(LinearToSrgb(linearG) * 255.0f) << 8) |
+		PackChannel(LinearToSrgb(linearB) * 255.0f);
+
+}
+
+//Table lookup with linear interpolation, inputs clamped to [0, 1]
+float ColorSpaceConverter::Root(float value) const {
+
+	float position = value * static_cast<float>(ROOT_TABLE_SIZE);
+	if (position <= 0.0f) return m_rootTable[0];
+	if (position < ROOT_EXACT_POSITION) return m_colorSpace == COLOR_SPACE_CIELAB ? CielabF(value) : std::cbrt(value);
+	if (position >= static_cast<float>(ROOT_TABLE_SIZE)) return m_rootTable[ROOT_TABLE_SIZE];
+
+	uint32_t index = static_cast<uint32_t>(position);
+	float fraction = position - static_cast<float>(index);
+
+	return m_rootTable[index] + fraction * (m_rootTable[index + 1] - m_rootTable[index]);
+
+}
+
+}
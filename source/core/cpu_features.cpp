@@ -0,0 +1,104 @@
+#include <cpu_features.h>
+
+#if defined(VORONOI_CORE_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace VoronoiCore {
+
+#if defined(VORONOI_CORE_X86)
+
+namespace {
+
+void Cpuid(unsigned int leaf, unsigned int subleaf, unsigned int registers[4]) {
+
+#if defined(_MSC_VER)
+	int cpuInfo[4] = {};
+	__cpuidex(cpuInfo, static_cast<int>(leaf), static_cast<int>(subleaf));
+	for (unsigned int i = 0; i < 4; ++i) registers[i] = static_cast<unsigned int>(cpuInfo[i]);
+#else
+	__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+
+}
+
+//XCR0 - which register states the OS saves on context switch
+unsigned long long ReadXCR0() {
+
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	unsigned int eax = 0;
+	unsigned int edx = 0;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+
+}
+
+}
+
+SimdLevel DetectSimdLevel() {
+
+	unsigned int registers[4] = {};
+	Cpuid(0, 0, registers);
+	unsigned int maxLeaf = registers[0];
+
+	Cpuid(1, 0, registers);
+	bool hasSSE41 = (registers[2] & (1u << 19)) != 0;
+	bool hasOSXSAVE = (registers[2] & (1u << 27)) != 0;
+	bool hasAVX = (registers[2] & (1u << 28)) != 0;
+
+	//AVX2 needs the OS to save the YMM registers (XCR0 bits 1 and 2)
+	bool hasAVX2 = false;
+	if (maxLeaf >= 7 && hasOSXSAVE && hasAVX && (ReadXCR0() & 0x6) == 0x6) {
+
+		Cpuid(7, 0, registers);
+		hasAVX2 = (registers[1] & (1u << 5)) != 0;
+
+	}
+
+	if (hasAVX2) return SIMD_LEVEL_AVX2;
+	if (hasSSE41) return SIMD_LEVEL_SSE41;
+	return SIMD_LEVEL_SCALAR;
+
+}
+
+#elif defined(VORONOI_CORE_NEON)
+
+//NEON is mandatory on AArch64
+SimdLevel DetectSimdLevel() {
+
+	return SIMD_LEVEL_NEON;
+
+}
+
+#else
+
+SimdLevel DetectSimdLevel() {
+
+	return SIMD_LEVEL_SCALAR;
+
+}
+
+#endif
+
+const char* GetSimdLevelName(SimdLevel simdLevel) {
+
+	switch (simdLevel) {
+
+	case SIMD_LEVEL_SSE41: return "SSE4.1";
+	case SIMD_LEVEL_AVX2: return "AVX2";
+	case SIMD_LEVEL_NEON: return "NEON";
+	default: return "Scalar";
+
+	}
+
+}
+
+}
@@ -0,0 +1,712 @@
+#include <delaunay_triangulation.h>
+
+#include <geometric_predicates.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace VoronoiCore {
+
+namespace {
+
+//Z-order bits per axis of the insertion order
+const uint32_t MORTON_BITS = 10;
+
+//Spread the low 10 bits of value to every third bit
+uint32_t SpreadBits(uint32_t value) {
+
+	value &= 0x3FF;
+	value = (value | (value << 16)) & 0x030000FF;
+	value = (value | (value << 8)) & 0x0300F00F;
+	value = (value | (value << 4)) & 0x030C30C3;
+	value = (value | (value << 2)) & 0x09249249;
+
+	return value;
+
+}
+
+uint32_t MortonCode(const Point& point) {
+
+	const float scale = static_cast<float>((1u << MORTON_BITS) - 1);
+	float coordinates[3] = { point.x, point.y, point.z };
+	uint32_t cells[3];
+
+	for (uint32_t i = 0; i < 3; ++i) {
+
+		float coordinate = coordinates[i] < 0.0f ? 0.0f : (coordinates[i] > 1.0f ? 1.0f : coordinates[i]);
+		cells[i] = static_cast<uint32_t>(coordinate * scale + 0.5f);
+
+	}
+
+	return (SpreadBits(cells[0]) << 2) | (SpreadBits(cells[1]) << 1) | SpreadBits(cells[2]);
+
+}
+
+//The super tetrahedron's vertices are alternate corners of a cube of this half side around the unit cube's centre. Its insphere
+//radius is the half side / sqrt(3) = sqrt(3 / 2), which contains the unit cube's circumsphere of radius sqrt(3) / 2 with margin
+const float UNIT_CUBE_HALF_SIDE = 3.0f / std::sqrt(2.0f);
+
+//The points around a hole can be super vertices, the hole triangulation's super tetrahedron is the unit cube's scaled around the
+//centre of the cube so it holds them all
+const float HOLE_HALF_SIDE = 4.0f * UNIT_CUBE_HALF_SIDE;
+
+//Bits per vertex of a hole face key, larger triangulations are built again instead of filling holes
+const uint32_t FACE_KEY_BITS = 21;
+
+uint64_t FaceKey(int32_t a, int32_t b, int32_t c) {
+
+	if (a > b) std::swap(a, b);
+	if (b > c) std::swap(b, c);
+	if (a > b) std::swap(a, b);
+
+	return (static_cast<uint64_t>(a) << (2 * FACE_KEY_BITS)) | (static_cast<uint64_t>(b) << FACE_KEY_BITS) | static_cast<uint64_t>(c);
+
+}
+
+}
+
+DelaunayTriangulation::DelaunayTriangulation() : m_pointCount(0), m_insertedCount(0), m_lastTetrahedron(NO_TETRAHEDRON), m_cavityStamp(0) {}
+
+DelaunayTriangulation::~DelaunayTriangulation() {}
+
+void DelaunayTriangulation::Build(const Point* points, uint32_t pointCount) {
+
+	Triangulate(points, pointCount, UNIT_CUBE_HALF_SIDE);
+
+}
+
+//Super tetrahedron on alternate corners of a cube of half side halfSide centered on the unit cube, a larger one for the triangulation
+//filling a hole
+void DelaunayTriangulation::Triangulate(const Point* points, uint32_t pointCount, float halfSide) {
+
+	m_pointCount = pointCount;
+	m_vertices.assign(points, points + pointCount);
+	m_isInserted.assign(pointCount, 0);
+	m_insertedCount = 0;
+	m_vertexTetrahedrons.assign(pointCount + 4, NO_TETRAHEDRON);
+
+	m_tetrahedrons.clear();
+	m_freeTetrahedrons.clear();
+	m_cavityStamps.clear();
+	m_cavityStamp = 0;
+
+	m_vertices.emplace_back(halfSide + 0.5f, halfSide + 0.5f, halfSide + 0.5f);
+	m_vertices.emplace_back(halfSide + 0.5f, -halfSide + 0.5f, -halfSide + 0.5f);
+	m_vertices.emplace_back(-halfSide + 0.5f, halfSide + 0.5f, -halfSide + 0.5f);
+	m_vertices.emplace_back(-halfSide + 0.5f, -halfSide + 0.5f, halfSide + 0.5f);
+
+	int32_t superTetrahedron = AllocateTetrahedron();
+	DelaunayTetrahedron& tetrahedron = m_tetrahedrons[superTetrahedron];
+	for (int32_t i = 0; i < 4; ++i) {
+
+		tetrahedron.vertices[i] = static_cast<int32_t>(pointCount) + i;
+		tetrahedron.neighbors[i] = NO_TETRAHEDRON;
+		m_vertexTetrahedrons[pointCount + i] = superTetrahedron;
+
+	}
+	if (Orient3d(m_vertices[tetrahedron.vertices[0]], m_vertices[tetrahedron.vertices[1]], m_vertices[tetrahedron.vertices[2]],
+		m_vertices[tetrahedron.vertices[3]]) < 0.0) std::swap(tetrahedron.vertices[2], tetrahedron.vertices[3]);
+
+	m_lastTetrahedron = superTetrahedron;
+
+	//Z-order insertion keeps every point close to the previous one
+	m_insertionOrder.resize(pointCount);
+	for (uint32_t i = 0; i < pointCount; ++i) m_insertionOrder[i] = (static_cast<uint64_t>(MortonCode(points[i])) << 32) | i;
+	std::sort(m_insertionOrder.begin(), m_insertionOrder.end());
+
+	for (uint32_t i = 0; i < pointCount; ++i) {
+
+		uint32_t point = static_cast<uint32_t>(m_insertionOrder[i] & 0xFFFFFFFF);
+		m_isInserted[point] = Insert(static_cast<int32_t>(point)) ? 1 : 0;
+		m_insertedCount += m_isInserted[point];
+
+	}
+
+}
+
+uint32_t DelaunayTriangulation::GetPointCount() const {
+
+	return m_pointCount;
+
+}
+
+const std::vector<Point>& DelaunayTriangulation::GetVertices() const {
+
+	return m_vertices;
+
+}
+
+bool DelaunayTriangulation::IsSuperVertex(int32_t vertex) const {
+
+	return vertex >= static_cast<int32_t>(m_pointCount);
+
+}
+
+bool DelaunayTriangulation::IsInserted(uint32_t point) const {
+
+	return m_isInserted[point] != 0;
+
+}
+
+uint32_t DelaunayTriangulation::GetInsertedCount() const {
+
+	return m_insertedCount;
+
+}
+
+const std::vector<DelaunayTetrahedron>& DelaunayTriangulation::GetTetrahedrons() const {
+
+	return m_tetrahedrons;
+
+}
+
+bool DelaunayTriangulation::IsFree(int32_t tetrahedron) const {
+
+	return m_tetrahedrons[tetrahedron].vertices[0] == NO_VERTEX;
+
+}
+
+uint32_t DelaunayTriangulation::GetTetrahedronCount() const {
+
+	return static_cast<uint32_t>(m_tetrahedrons.size() - m_freeTetrahedrons.size());
+
+}
+
+//Visibility walk - step across a face the point lies beyond until there is none, the first face checked rotates every step so
+//degenerate configurations cannot trap the walk in a cycle. A walk that takes too long falls back to checking every tetrahedron
+int32_t DelaunayTriangulation::Locate(const Point& point, int32_t start) const {
+
+	int32_t tetrahedron = start;
+	if (tetrahedron == NO_TETRAHEDRON || IsFree(tetrahedron)) {
+
+		tetrahedron = NO_TETRAHEDRON;
+		for (int32_t i = 0; i < static_cast<int32_t>(m_tetrahedrons.size()) && tetrahedron == NO_TETRAHEDRON; ++i) {
+
+			if (!IsFree(i)) tetrahedron = i;
+
+		}
+		if (tetrahedron == NO_TETRAHEDRON) return NO_TETRAHEDRON;
+
+	}
+
+	size_t maxStepCount = m_tetrahedrons.size() + 4;
+	for (size_t step = 0; step < maxStepCount; ++step) {
+
+		int32_t next = tetrahedron;
+		for (int32_t i = 0; i < 4; ++i) {
+
+			int32_t face = static_cast<int32_t>((static_cast<size_t>(i) + step) & 3);
+			if (FaceOrientation(tetrahedron, face, point) < 0.0) {
+
+				next = m_tetrahedrons[tetrahedron].neighbors[face];
+				break;
+
+			}
+
+		}
+
+		if (next == tetrahedron) return tetrahedron;
+		if (next == NO_TETRAHEDRON) return NO_TETRAHEDRON;
+		tetrahedron = next;
+
+	}
+
+	for (int32_t i = 0; i < static_cast<int32_t>(m_tetrahedrons.size()); ++i) {
+
+		if (IsFree(i)) continue;
+
+		bool isInside = true;
+		for (int32_t face = 0; face < 4 && isInside; ++face) isInside = FaceOrientation(i, face, point) >= 0.0;
+		if (isInside) return i;
+
+	}
+
+	return NO_TETRAHEDRON;
+
+}
+
+//Check the tetrahedrons around the point at the new position, a move they do not survive removes the point and inserts it again
+bool DelaunayTriangulation::MovePoint(uint32_t point, const Point& position) {
+
+	if (point >= m_pointCount || !IsInserted(point)) return false;
+
+	int32_t vertex = static_cast<int32_t>(point);
+	int32_t start = m_vertexTetrahedrons[vertex];
+	if (start == NO_TETRAHEDRON || IsFree(start) || !HasVertex(start, vertex)) return false;
+
+	CollectStar(vertex, start);
+
+	Point previousPosition = m_vertices[vertex];
+	m_vertices[vertex] = position;
+
+	bool isDelaunay = true;
+	for (size_t i = 0; i < m_cavity.size() && isDelaunay; ++i) {
+
+		const int32_t* vertices = m_tetrahedrons[m_cavity[i]].vertices;
+		isDelaunay = Orient3d(m_vertices[vertices[0]], m_vertices[vertices[1]], m_vertices[vertices[2]], m_vertices[vertices[3]]) > 0.0;
+		for (int32_t face = 0; face < 4 && isDelaunay; ++face) isDelaunay = IsLocallyDelaunay(m_cavity[i], face);
+
+	}
+
+	if (isDelaunay) return true;
+
+	m_vertices[vertex] = previousPosition;
+	if (!RemoveVertex(vertex)) return false;
+
+	m_vertices[vertex] = position;
+	if (Insert(vertex)) return true;
+
+	m_isInserted[point] = 0;
+	--m_insertedCount;
+
+	return false;
+
+}
+
+double DelaunayTriangulation::FaceOrientation(int32_t tetrahedron, int32_t face, const Point& point) const {
+
+	const int32_t* vertices = m_tetrahedrons[tetrahedron].vertices;
+	const Point* corners[4] = { &m_vertices[vertices[0]], &m_vertices[vertices[1]], &m_vertices[vertices[2]], &m_vertices[vertices[3]] };
+	corners[face] = &point;
+
+	return Orient3d(*corners[0], *corners[1], *corners[2], *corners[3]);
+
+}
+
+double DelaunayTriangulation::InSphere(int32_t tetrahedron, const Point& point) const {
+
+	const int32_t* vertices = m_tetrahedrons[tetrahedron].vertices;
+
+	return VoronoiCore::InSphere(m_vertices[vertices[0]], m_vertices[vertices[1]], m_vertices[vertices[2]], m_vertices[vertices[3]], point);
+
+}
+
+bool DelaunayTriangulation::HasVertex(int32_t tetrahedron, int32_t vertex) const {
+
+	const int32_t* vertices = m_tetrahedrons[tetrahedron].vertices;
+
+	return vertices[0] == vertex || vertices[1] == vertex || vertices[2] == vertex || vertices[3] == vertex;
+
+}
+
+bool DelaunayTriangulation::HasSuperVertex(int32_t tetrahedron) const {
+
+	const int32_t* vertices = m_tetrahedrons[tetrahedron].vertices;
+
+	return IsSuperVertex(vertices[0]) || IsSuperVertex(vertices[1]) || IsSuperVertex(vertices[2]) || IsSuperVertex(vertices[3]);
+
+}
+
+//The vertex of the neighbour across the face lies outside or on the circumsphere of the tetrahedron - the same test from the
+//neighbour's side has the same sign, a face is checked from one side only
+bool DelaunayTriangulation::IsLocallyDelaunay(int32_t tetrahedron, int32_t face) const {
+
+	int32_t neighbor = m_tetrahedrons[tetrahedron].neighbors[face];
+	if (neighbor == NO_TETRAHEDRON) return true;
+
+	const DelaunayTetrahedron& neighborTetrahedron = m_tetrahedrons[neighbor];
+	for (int32_t i = 0; i < 4; ++i) {
+
+		if (neighborTetrahedron.neighbors[i] == tetrahedron) return InSphere(tetrahedron, m_vertices[neighborTetrahedron.vertices[i]]) <= 0.0;
+
+	}
+
+	return true;
+
+}
+
+//Bowyer-Watson step - the tetrahedrons whose circumspheres hold the point are replaced by the tetrahedrons joining the point to the
+//faces of their union, new neighbours are linked across the outside faces and, through the cavity edges they share, to each other
+bool DelaunayTriangulation::Insert(int32_t vertex) {
+
+	const Point& point = m_vertices[vertex];
+
+	int32_t start = Locate(point, m_lastTetrahedron);
+	if (start == NO_TETRAHEDRON) return false;
+
+	for (int32_t i = 0; i < 4; ++i) {
+
+		const Point& corner = m_vertices[m_tetrahedrons[start].vertices[i]];
+		if (corner.x == point.x && corner.y == point.y && corner.z == point.z) return false;
+
+	}
+
+	if (++m_cavityStamp == 0) {
+
+		std::fill(m_cavityStamps.begin(), m_cavityStamps.end(), 0);
+		m_cavityStamp = 1;
+
+	}
+
+	//Breadth first over the neighbours, the cavity stays connected
+	m_cavity.clear();
+	AddToCavity(start);
+	for (size_t i = 0; i < m_cavity.size(); ++i) {
+
+		for (int32_t face = 0; face < 4; ++face) {
+
+			int32_t neighbor = m_tetrahedrons[m_cavity[i]].neighbors[face];
+			if (neighbor != NO_TETRAHEDRON && !IsInCavity(neighbor) && InSphere(neighbor, point) > 0.0) AddToCavity(neighbor);
+
+		}
+
+	}
+
+	if (!FindCavityBoundary(point)) return false;
+
+	m_cavityEdges.clear();
+	int32_t newTetrahedron = NO_TETRAHEDRON;
+	for (size_t i = 0; i < m_cavityFaces.size(); ++i) {
+
+		const CavityFace& cavityFace = m_cavityFaces[i];
+
+		newTetrahedron = AllocateTetrahedron();
+		DelaunayTetrahedron& tetrahedron = m_tetrahedrons[newTetrahedron];
+		tetrahedron = m_tetrahedrons[cavityFace.tetrahedron];
+		tetrahedron.vertices[cavityFace.face] = vertex;
+		for (int32_t j = 0; j < 4; ++j) tetrahedron.neighbors[j] = NO_TETRAHEDRON;
+		tetrahedron.neighbors[cavityFace.face] = cavityFace.outside;
+		for (int32_t j = 0; j < 4; ++j) m_vertexTetrahedrons[tetrahedron.vertices[j]] = newTetrahedron;
+
+		if (cavityFace.outside != NO_TETRAHEDRON) {
+
+			int32_t* outsideNeighbors = m_tetrahedrons[cavityFace.outside].neighbors;
+			for (int32_t j = 0; j < 4; ++j) {
+
+				if (outsideNeighbors[j] == cavityFace.tetrahedron) {
+
+					outsideNeighbors[j] = newTetrahedron;
+					break;
+
+				}
+
+			}
+
+		}
+
+		//The other faces hold the point and one edge of the cavity face
+		for (int32_t j = 0; j < 4; ++j) {
+
+			if (j == cavityFace.face) continue;
+
+			int32_t edgeVertices[2];
+			int32_t edgeVertexCount = 0;
+			for (int32_t k = 0; k < 4; ++k) {
+
+				if (k != j && k != cavityFace.face) edgeVertices[edgeVertexCount++] = tetrahedron.vertices[k];
+
+			}
+			if (edgeVertices[0] > edgeVertices[1]) std::swap(edgeVertices[0], edgeVertices[1]);
+
+			CavityEdge cavityEdge = { (static_cast<uint64_t>(edgeVertices[0]) << 32) | static_cast<uint32_t>(edgeVertices[1]), newTetrahedron, j };
+			m_cavityEdges.push_back(cavityEdge);
+
+		}
+
+	}
+
+	//Every cavity edge is shared by exactly two new tetrahedrons
+	std::sort(m_cavityEdges.begin(), m_cavityEdges.end(), [](const CavityEdge& a, const CavityEdge& b) { return a.key < b.key; });
+	for (size_t i = 0; i + 1 < m_cavityEdges.size(); i += 2) {
+
+		const CavityEdge& a = m_cavityEdges[i];
+		const CavityEdge& b = m_cavityEdges[i + 1];
+		m_tetrahedrons[a.tetrahedron].neighbors[a.face] = b.tetrahedron;
+		m_tetrahedrons[b.tetrahedron].neighbors[b.face] = a.tetrahedron;
+
+	}
+
+	for (size_t i = 0; i < m_cavity.size(); ++i) FreeTetrahedron(m_cavity[i]);
+	m_lastTetrahedron = newTetrahedron;
+
+	return true;
+
+}
+
+bool DelaunayTriangulation::IsInCavity(int32_t tetrahedron) const {
+
+	return m_cavityStamps[tetrahedron] == m_cavityStamp;
+
+}
+
+void DelaunayTriangulation::AddToCavity(int32_t tetrahedron) {
+
+	m_cavityStamps[tetrahedron] = m_cavityStamp;
+	m_cavity.push_back(tetrahedron);
+
+}
+
+//Collect the outside faces of the cavity - the point must strictly see every one of them for the new tetrahedrons to be valid,
+//co-spherical points left out of the cavity can leave a face it does not see, the tetrahedron behind that face then joins the cavity
+//False when the point does not see an outer face of the super tetrahedron, the point lies on or outside it
+bool DelaunayTriangulation::FindCavityBoundary(const Point& point) {
+
+	bool isBoundaryValid = false;
+	while (!isBoundaryValid) {
+
+		isBoundaryValid = true;
+		m_cavityFaces.clear();
+
+		for (size_t i = 0; i < m_cavity.size() && isBoundaryValid; ++i) {
+
+			int32_t tetrahedron = m_cavity[i];
+			for (int32_t face = 0; face < 4; ++face) {
+
+				int32_t neighbor = m_tetrahedrons[tetrahedron].neighbors[face];
+				if (neighbor != NO_TETRAHEDRON && IsInCavity(neighbor)) continue;
+
+				if (FaceOrientation(tetrahedron, face, point) <= 0.0) {
+
+					if (neighbor == NO_TETRAHEDRON) return false;
+
+					AddToCavity(neighbor);
+					isBoundaryValid = false;
+					break;
+
+				}
+
+				CavityFace cavityFace = { tetrahedron, face, neighbor };
+				m_cavityFaces.push_back(cavityFace);
+
+			}
+
+		}
+
+	}
+
+	return true;
+
+}
+
+//Tetrahedrons holding the vertex into m_cavity, breadth first over the neighbours holding it
+void DelaunayTriangulation::CollectStar(int32_t vertex, int32_t start) {
+
+	if (++m_cavityStamp == 0) {
+
+		std::fill(m_cavityStamps.begin(), m_cavityStamps.end(), 0);
+		m_cavityStamp = 1;
+
+	}
+
+	m_cavity.clear();
+	AddToCavity(start);
+	for (size_t i = 0; i < m_cavity.size(); ++i) {
+
+		for (int32_t face = 0; face < 4; ++face) {
+
+			int32_t neighbor = m_tetrahedrons[m_cavity[i]].neighbors[face];
+			if (neighbor != NO_TETRAHEDRON && !IsInCavity(neighbor) && HasVertex(neighbor, vertex)) AddToCavity(neighbor);
+
+		}
+
+	}
+
+}
+
+//Replace the tetrahedrons around the vertex, collected in m_cavity, by the tetrahedrons of the Delaunay triangulation of the vertices
+//around it that lie inside the hole. The fill grows from the tetrahedrons behind the hole faces without crossing one, it has to meet
+//every hole face from the inside and be locally Delaunay against the tetrahedrons outside - co-spherical points can give a hole
+//triangulation that does not match the hole, the triangulation is then left as it was
+bool DelaunayTriangulation::RemoveVertex(int32_t vertex) {
+
+	if (m_vertices.size() > (static_cast<size_t>(1) << FACE_KEY_BITS)) return false;
+
+	m_linkVertices.clear();
+	m_holeFaces.clear();
+	for (size_t i = 0; i < m_cavity.size(); ++i) {
+
+		const int32_t* vertices = m_tetrahedrons[m_cavity[i]].vertices;
+		int32_t face = 0;
+		for (int32_t j = 0; j < 4; ++j) {
+
+			if (vertices[j] == vertex) face = j;
+			else m_linkVertices.push_back(vertices[j]);
+
+		}
+
+		HoleFace holeFace = { FaceKey(vertices[(face + 1) & 3], vertices[(face + 2) & 3], vertices[(face + 3) & 3]), m_cavity[i], face,
+			m_tetrahedrons[m_cavity[i]].neighbors[face], NO_TETRAHEDRON, 0 };
+		m_holeFaces.push_back(holeFace);
+
+	}
+
+	std::sort(m_linkVertices.begin(), m_linkVertices.end());
+	m_linkVertices.erase(std::unique(m_linkVertices.begin(), m_linkVertices.end()), m_linkVertices.end());
+	std::sort(m_holeFaces.begin(), m_holeFaces.end(), [](const HoleFace& a, const HoleFace& b) { return a.key < b.key; });
+
+	uint32_t linkCount = static_cast<uint32_t>(m_linkVertices.size());
+	m_linkPoints.resize(linkCount);
+	for (uint32_t i = 0; i < linkCount; ++i) m_linkPoints[i] = m_vertices[m_linkVertices[i]];
+
+	if (!m_holeTriangulation) m_holeTriangulation = std::make_unique<DelaunayTriangulation>();
+	DelaunayTriangulation& hole = *m_holeTriangulation;
+	hole.Triangulate(m_linkPoints.data(), linkCount, HOLE_HALF_SIDE);
+	if (hole.GetInsertedCount() != linkCount) return false;
+
+	//Hole faces seen from the tetrahedron on their inner side start the fill
+	const std::vector<DelaunayTetrahedron>& holeTetrahedrons = hole.m_tetrahedrons;
+	m_fill.clear();
+	m_fillIndices.assign(holeTetrahedrons.size(), NO_TETRAHEDRON);
+	for (int32_t t = 0; t < static_cast<int32_t>(holeTetrahedrons.size()); ++t) {
+
+		if (hole.IsFree(t) || hole.HasSuperVertex(t)) continue;
+
+		const int32_t* vertices = holeTetrahedrons[t].vertices;
+		for (int32_t f = 0; f < 4; ++f) {
+
+			int32_t holeFaceIndex = FindHoleFace(vertices[(f + 1) & 3], vertices[(f + 2) & 3], vertices[(f + 3) & 3]);
+			if (holeFaceIndex == NO_TETRAHEDRON) continue;
+
+			HoleFace& holeFace = m_holeFaces[holeFaceIndex];
+			if (FaceOrientation(holeFace.tetrahedron, holeFace.face, m_linkPoints[vertices[f]]) <= 0.0) continue;
+			if (holeFace.fill != NO_TETRAHEDRON) return false;
+
+			holeFace.fill = t;
+			holeFace.fillFace = f;
+			if (m_fillIndices[t] == NO_TETRAHEDRON) {
+
+				m_fillIndices[t] = static_cast<int32_t>(m_fill.size());
+				m_fill.push_back(t);
+
+			}
+
+		}
+
+	}
+
+	for (size_t i = 0; i < m_fill.size(); ++i) {
+
+		int32_t t = m_fill[i];
+		const int32_t* vertices = holeTetrahedrons[t].vertices;
+		for (int32_t f = 0; f < 4; ++f) {
+
+			int32_t holeFaceIndex = FindHoleFace(vertices[(f + 1) & 3], vertices[(f + 2) & 3], vertices[(f + 3) & 3]);
+			if (holeFaceIndex != NO_TETRAHEDRON) {
+
+				if (m_holeFaces[holeFaceIndex].fill != t) return false;
+				continue;
+
+			}
+
+			int32_t neighbor = holeTetrahedrons[t].neighbors[f];
+			if (neighbor == NO_TETRAHEDRON || hole.HasSuperVertex(neighbor)) return false;
+			if (m_fillIndices[neighbor] == NO_TETRAHEDRON) {
+
+				m_fillIndices[neighbor] = static_cast<int32_t>(m_fill.size());
+				m_fill.push_back(neighbor);
+
+			}
+
+		}
+
+	}
+
+	for (size_t i = 0; i < m_holeFaces.size(); ++i) {
+
+		const HoleFace& holeFace = m_holeFaces[i];
+		if (holeFace.fill == NO_TETRAHEDRON) return false;
+		if (holeFace.outside == NO_TETRAHEDRON) continue;
+
+		const DelaunayTetrahedron& outsideTetrahedron = m_tetrahedrons[holeFace.outside];
+		const int32_t* vertices = holeTetrahedrons[holeFace.fill].vertices;
+		for (int32_t j = 0; j < 4; ++j) {
+
+			if (outsideTetrahedron.neighbors[j] != holeFace.tetrahedron) continue;
+
+			if (VoronoiCore::InSphere(m_linkPoints[vertices[0]], m_linkPoints[vertices[1]], m_linkPoints[vertices[2]], m_linkPoints[vertices[3]],
+				m_vertices[outsideTetrahedron.vertices[j]]) > 0.0) return false;
+
+		}
+
+	}
+
+	//The fill is valid - copy it in, link it to the outside and free the tetrahedrons around the vertex
+	m_fillTetrahedrons.resize(m_fill.size());
+	for (size_t i = 0; i < m_fill.size(); ++i) m_fillTetrahedrons[i] = AllocateTetrahedron();
+
+	for (size_t i = 0; i < m_fill.size(); ++i) {
+
+		const DelaunayTetrahedron& holeTetrahedron = holeTetrahedrons[m_fill[i]];
+		DelaunayTetrahedron& tetrahedron = m_tetrahedrons[m_fillTetrahedrons[i]];
+		for (int32_t j = 0; j < 4; ++j) {
+
+			//Neighbours outside the fill are linked across the hole faces below
+			int32_t fillIndex = m_fillIndices[holeTetrahedron.neighbors[j]];
+			tetrahedron.vertices[j] = m_linkVertices[holeTetrahedron.vertices[j]];
+			tetrahedron.neighbors[j] = NO_TETRAHEDRON;
+			if (fillIndex != NO_TETRAHEDRON) tetrahedron.neighbors[j] = m_fillTetrahedrons[fillIndex];
+			m_vertexTetrahedrons[tetrahedron.vertices[j]] = m_fillTetrahedrons[i];
+
+		}
+
+	}
+
+	for (size_t i = 0; i < m_holeFaces.size(); ++i) {
+
+		const HoleFace& holeFace = m_holeFaces[i];
+		int32_t tetrahedron = m_fillTetrahedrons[m_fillIndices[holeFace.fill]];
+		m_tetrahedrons[tetrahedron].neighbors[holeFace.fillFace] = holeFace.outside;
+		if (holeFace.outside == NO_TETRAHEDRON) continue;
+
+		int32_t* outsideNeighbors = m_tetrahedrons[holeFace.outside].neighbors;
+		for (int32_t j = 0; j < 4; ++j) {
+
+			if (outsideNeighbors[j] == holeFace.tetrahedron) {
+
+				outsideNeighbors[j] = tetrahedron;
+				break;
+
+			}
+
+		}
+
+	}
+
+	for (size_t i = 0; i < m_cavity.size(); ++i) FreeTetrahedron(m_cavity[i]);
+	m_lastTetrahedron = m_fillTetrahedrons[0];
+
+	return true;
+
+}
+
+//Hole face with the link vertices of the hole triangulation, NO_TETRAHEDRON when the face is not on the hole
+int32_t DelaunayTriangulation::FindHoleFace(int32_t a, int32_t b, int32_t c) const {
+
+	uint64_t key = FaceKey(m_linkVertices[a], m_linkVertices[b], m_linkVertices[c]);
+	auto holeFace = std::lower_bound(m_holeFaces.begin(), m_holeFaces.end(), key, [](const HoleFace& face, uint64_t value) { return face.key < value; });
+	if (holeFace == m_holeFaces.end() || holeFace->key != key) return NO_TETRAHEDRON;
+
+	return static_cast<int32_t>(holeFace - m_holeFaces.begin());
+
+}
+
+int32_t DelaunayTriangulation::AllocateTetrahedron() {
+
+	if (!m_freeTetrahedrons.empty()) {
+
+		int32_t tetrahedron = m_freeTetrahedrons.back();
+		m_freeTetrahedrons.pop_back();
+		return tetrahedron;
+
+	}
+
+	m_tetrahedrons.emplace_back();
+	m_cavityStamps.push_back(0);
+
+	return static_cast<int32_t>(m_tetrahedrons.size() - 1);
+
+}
+
+void DelaunayTriangulation::FreeTetrahedron(int32_t tetrahedron) {
+
+	for (int32_t i = 0; i < 4; ++i) {
+
+		m_tetrahedrons[tetrahedron].vertices[i] = NO_VERTEX;
+		m_tetrahedrons[tetrahedron].neighbors[i] = NO_TETRAHEDRON;
+
+	}
+	m_freeTetrahedrons.push_back(tetrahedron);
+
+}
+
+}
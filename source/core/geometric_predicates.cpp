@@ -0,0 +1,389 @@
+#include <geometric_predicates.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace VoronoiCore {
+
+namespace {
+
+//Half an ulp of 1.0 and the splitter of a double into two 26-bit halves
+const double EPSILON = 1.1102230246251565e-16;
+const double SPLITTER = 134217729.0;
+
+//Error bounds of the double evaluations relative to their permanents
+const double ORIENT3D_ERROR_BOUND = (7.0 + 56.0 * EPSILON) * EPSILON;
+const double INSPHERE_ERROR_BOUND = (16.0 + 224.0 * EPSILON) * EPSILON;
+
+//Longest expansions of the exact determinants - a 3x3 minor is three 8 component terms, the orientation on raw coordinates four minors,
+//a lift scales an expansion to 12 times its length
+const uint32_t MINOR3_LENGTH = 24;
+const uint32_t ORIENT3D_LENGTH = 4 * MINOR3_LENGTH;
+const uint32_t INSPHERE_LENGTH = 5 * 12 * ORIENT3D_LENGTH;
+
+//An expansion is a sum of nonoverlapping doubles by increasing magnitude, its last component has the sign of the sum
+
+//sum + error == a + b exactly
+void TwoSum(double a, double b, double* sum, double* error) {
+
+	*sum = a + b;
+	double bVirtual = *sum - a;
+	double aVirtual = *sum - bVirtual;
+	*error = (a - aVirtual) + (b - bVirtual);
+
+}
+
+void Split(double a, double* high, double* low) {
+
+	double c = SPLITTER * a;
+	*high = c - (c - a);
+	*low = a - *high;
+
+}
+
+//product + error == a * b exactly
+void TwoProduct(double a, double b, double* product, double* error) {
+
+	*product = a * b;
+
+	double aHigh, aLow, bHigh, bLow;
+	Split(a, &aHigh, &aLow);
+	Split(b, &bHigh, &bLow);
+	*error = aLow * bLow - (((*product - aHigh * bHigh) - aLow * bHigh) - aHigh * bLow);
+
+}
+
+//h = e + f, components merged by increasing magnitude and zero components left out
+uint32_t ExpansionSum(const double* e, uint32_t eLength, const double* f, uint32_t fLength, double* h) {
+
+	uint32_t eIndex = 0;
+	uint32_t fIndex = 0;
+	uint32_t hLength = 0;
+
+	double sum = std::fabs(e[0]) < std::fabs(f[0]) ? e[eIndex++] : f[fIndex++];
+	while (eIndex < eLength || fIndex < fLength) {
+
+		double next;
+		if (fIndex == fLength || (eIndex < eLength && std::fabs(e[eIndex]) < std::fabs(f[fIndex]))) next = e[eIndex++];
+		else next = f[fIndex++];
+
+		double error;
+		TwoSum(sum, next, &sum, &error);
+		if (error != 0.0) h[hLength++] = error;
+
+	}
+
+	if (sum != 0.0 || hLength == 0) h[hLength++] = sum;
+
+	return hLength;
+
+}
+
+//h = e * b, zero components left out
+uint32_t ScaleExpansion(const double* e, uint32_t eLength, double b, double* h) {
+
+	uint32_t hLength = 0;
+
+	double sum, error;
+	TwoProduct(e[0], b, &sum, &error);
+	if (error != 0.0) h[hLength++] = error;
+
+	for (uint32_t i = 1; i < eLength; ++i) {
+
+		double product, productError;
+		TwoProduct(e[i], b, &product, &productError);
+
+		double partial;
+		TwoSum(sum, productError, &partial, &error);
+		if (error != 0.0) h[hLength++] = error;
+		TwoSum(product, partial, &sum, &error);
+		if (error != 0.0) h[hLength++] = error;
+
+	}
+
+	if (sum != 0.0 || hLength == 0) h[hLength++] = sum;
+
+	return hLength;
+
+}
+
+void Negate(double* e, uint32_t length) {
+
+	for (uint32_t i = 0; i < length; ++i) e[i] = -e[i];
+
+}
+
+//point - origin, false when a difference was rounded - differences of floats are exact in double unless their exponents are far apart
+bool ExactDifference(const Point& point, const Point& origin, double* difference) {
+
+	double errors[3];
+	TwoSum(point.x, -static_cast<double>(origin.x), &difference[0], &errors[0]);
+	TwoSum(point.y, -static_cast<double>(origin.y), &difference[1], &errors[1]);
+	TwoSum(point.z, -static_cast<double>(origin.z), &difference[2], &errors[2]);
+
+	return errors[0] == 0.0 && errors[1] == 0.0 && errors[2] == 0.0;
+
+}
+
+//p[0] * q[1] - q[0] * p[1]
+uint32_t ExactMinor2(const double* p, const double* q, double* h) {
+
+	double pq[2];
+	double qp[2];
+	TwoProduct(p[0], q[1], &pq[1], &pq[0]);
+	TwoProduct(q[0], p[1], &qp[1], &qp[0]);
+	Negate(qp, 2);
+
+	return ExpansionSum(pq, 2, qp, 2, h);
+
+}
+
+//Determinant of the rows p, q, r
+uint32_t ExactMinor3(const double* p, const double* q, const double* r, double* h) {
+
+	double qr[4], pr[4], pq[4];
+	uint32_t qrLength = ExactMinor2(q, r, qr);
+	uint32_t prLength = ExactMinor2(p, r, pr);
+	uint32_t pqLength = ExactMinor2(p, q, pq);
+
+	double pTerm[8], qTerm[8], rTerm[8], pqTerms[16];
+	uint32_t pTermLength = ScaleExpansion(qr, qrLength, p[2], pTerm);
+	uint32_t qTermLength = ScaleExpansion(pr, prLength, -q[2], qTerm);
+	uint32_t rTermLength = ScaleExpansion(pq, pqLength, r[2], rTerm);
+	uint32_t pqTermsLength = ExpansionSum(pTerm, pTermLength, qTerm, qTermLength, pqTerms);
+
+	return ExpansionSum(pqTerms, pqTermsLength, rTerm, rTermLength, h);
+
+}
+
+//h = (p[0]^2 + p[1]^2 + p[2]^2) * e one coordinate at a time, e at most ORIENT3D_LENGTH long
+uint32_t ScaleByLift(const double* p, const double* e, uint32_t eLength, double* h) {
+
+	double scaled[2 * ORIENT3D_LENGTH];
+	double squared[2][4 * ORIENT3D_LENGTH];
+	double partial[8 * ORIENT3D_LENGTH];
+	uint32_t squaredLengths[2];
+
+	for (uint32_t k = 0; k < 2; ++k) {
+
+		uint32_t scaledLength = ScaleExpansion(e, eLength, p[k], scaled);
+		squaredLengths[k] = ScaleExpansion(scaled, scaledLength, p[k], squared[k]);
+
+	}
+	uint32_t partialLength = ExpansionSum(squared[0], squaredLengths[0], squared[1], squaredLengths[1], partial);
+
+	uint32_t scaledLength = ScaleExpansion(e, eLength, p[2], scaled);
+	squaredLengths[0] = ScaleExpansion(scaled, scaledLength, p[2], squared[0]);
+
+	return ExpansionSum(partial, partialLength, squared[0], squaredLengths[0], h);
+
+}
+
+//Orient3d as the cofactor expansion of the 4x4 determinant with a column of ones, for points whose differences are not exact
+uint32_t ExactOrient3d(const Point& a, const Point& b, const Point& c, const Point& d, double* h) {
+
+	const double rows[4][3] = { { a.x, a.y, a.z }, { b.x, b.y, b.z }, { c.x, c.y, c.z }, { d.x, d.y, d.z } };
+
+	double bcd[MINOR3_LENGTH], acd[MINOR3_LENGTH], abd[MINOR3_LENGTH], abc[MINOR3_LENGTH];
+	uint32_t bcdLength = ExactMinor3(rows[1], rows[2], rows[3], bcd);
+	uint32_t acdLength = ExactMinor3(rows[0], rows[2], rows[3], acd);
+	uint32_t abdLength = ExactMinor3(rows[0], rows[1], rows[3], abd);
+	uint32_t abcLength = ExactMinor3(rows[0], rows[1], rows[2], abc);
+	Negate(acd, acdLength);
+	Negate(abc, abcLength);
+
+	double first[2 * MINOR3_LENGTH], second[2 * MINOR3_LENGTH];
+	uint32_t firstLength = ExpansionSum(bcd, bcdLength, acd, acdLength, first);
+	uint32_t secondLength = ExpansionSum(abd, abdLength, abc, abcLength, second);
+
+	return ExpansionSum(first, firstLength, second, secondLength, h);
+
+}
+
+//The double evaluation on exact differences from e - every lift times the 3x3 minor of the other three differences
+double ExactInSphere(const double* ae, const double* be, const double* ce, const double* de) {
+
+	const double* differences[4] = { ae, be, ce, de };
+
+	double minor[MINOR3_LENGTH];
+	double lifted[4][12 * MINOR3_LENGTH];
+	uint32_t liftedLengths[4];
+
+	for (uint32_t i = 0; i < 4; ++i) {
+
+		const double* others[3];
+		uint32_t otherCount = 0;
+		for (uint32_t j = 0; j < 4; ++j) {
+
+			if (j != i) others[otherCount++] = differences[j];
+
+		}
+
+		//Cofactors alternate in sign, a's is positive
+		uint32_t minorLength = ExactMinor3(others[0], others[1], others[2], minor);
+		if ((i & 1) != 0) Negate(minor, minorLength);
+		liftedLengths[i] = ScaleByLift(differences[i], minor, minorLength, lifted[i]);
+
+	}
+
+	double first[24 * MINOR3_LENGTH], second[24 * MINOR3_LENGTH], sum[48 * MINOR3_LENGTH];
+	uint32_t firstLength = ExpansionSum(lifted[0], liftedLengths[0], lifted[1], liftedLengths[1], first);
+	uint32_t secondLength = ExpansionSum(lifted[2], liftedLengths[2], lifted[3], liftedLengths[3], second);
+	uint32_t sumLength = ExpansionSum(first, firstLength, second, secondLength, sum);
+
+	return sum[sumLength - 1];
+
+}
+
+//InSphere as the cofactor expansion of the 5x5 determinant along its lift column, for points whose differences are not exact
+double ExactInSphere(const Point& a, const Point& b, const Point& c, const Point& d, const Point& e) {
+
+	const Point* points[5] = { &a, &b, &c, &d, &e };
+
+	double orientation[ORIENT3D_LENGTH];
+	double lifted[12 * ORIENT3D_LENGTH];
+	double sums[2][INSPHERE_LENGTH];
+	uint32_t sumLength = 0;
+	uint32_t current = 0;
+
+	for (uint32_t i = 0; i < 5; ++i) {
+
+		const Point* others[4];
+		uint32_t otherCount = 0;
+		for (uint32_t j = 0; j < 5; ++j) {
+
+			if (j != i) others[otherCount++] = points[j];
+
+		}
+
+		//The cofactors alternate in sign, the determinant is negated so that inside is positive as in the double evaluation
+		uint32_t orientationLength = ExactOrient3d(*others[0], *others[1], *others[2], *others[3], orientation);
+		if ((i & 1) == 0) Negate(orientation, orientationLength);
+
+		const double point[3] = { points[i]->x, points[i]->y, points[i]->z };
+		uint32_t liftedLength = ScaleByLift(point, orientation, orientationLength, lifted);
+
+		if (sumLength == 0) {
+
+			for (uint32_t m = 0; m < liftedLength; ++m) sums[current][m] = lifted[m];
+			sumLength = liftedLength;
+
+		}
+		else {
+
+			sumLength = ExpansionSum(sums[current], sumLength, lifted, liftedLength, sums[current ^ 1]);
+			current ^= 1;
+
+		}
+
+	}
+
+	return sums[current][sumLength - 1];
+
+}
+
+}
+
+double Orient3d(const Point& a, const Point& b, const Point& c, const Point& d) {
+
+	double abX = static_cast<double>(b.x) - a.x;
+	double abY = static_cast<double>(b.y) - a.y;
+	double abZ = static_cast<double>(b.z) - a.z;
+	double acX = static_cast<double>(c.x) - a.x;
+	double acY = static_cast<double>(c.y) - a.y;
+	double acZ = static_cast<double>(c.z) - a.z;
+	double adX = static_cast<double>(d.x) - a.x;
+	double adY = static_cast<double>(d.y) - a.y;
+	double adZ = static_cast<double>(d.z) - a.z;
+
+	double abYacZ = abY * acZ;
+	double abZacY = abZ * acY;
+	double abXacZ = abX * acZ;
+	double abZacX = abZ * acX;
+	double abXacY = abX * acY;
+	double abYacX = abY * acX;
+
+	double determinant = adX * (abYacZ - abZacY) - adY * (abXacZ - abZacX) + adZ * (abXacY - abYacX);
+	double permanent = std::fabs(adX) * (std::fabs(abYacZ) + std::fabs(abZacY)) + std::fabs(adY) * (std::fabs(abXacZ) + std::fabs(abZacX)) +
+		std::fabs(adZ) * (std::fabs(abXacY) + std::fabs(abYacX));
+
+	double errorBound = ORIENT3D_ERROR_BOUND * permanent;
+	if (determinant > errorBound || -determinant > errorBound) return determinant;
+
+	double exact[ORIENT3D_LENGTH];
+	uint32_t exactLength;
+	double ab[3], ac[3], ad[3];
+	if (ExactDifference(b, a, ab) && ExactDifference(c, a, ac) && ExactDifference(d, a, ad)) exactLength = ExactMinor3(ab, ac, ad, exact);
+	else exactLength = ExactOrient3d(a, b, c, d, exact);
+
+	return exact[exactLength - 1];
+
+}
+
+double InSphere(const Point& a, const Point& b, const Point& c, const Point& d, const Point& e) {
+
+	double aeX = static_cast<double>(a.x) - e.x;
+	double aeY = static_cast<double>(a.y) - e.y;
+	double aeZ = static_cast<double>(a.z) - e.z;
+	double beX = static_cast<double>(b.x) - e.x;
+	double beY = static_cast<double>(b.y) - e.y;
+	double beZ = static_cast<double>(b.z) - e.z;
+	double ceX = static_cast<double>(c.x) - e.x;
+	double ceY = static_cast<double>(c.y) - e.y;
+	double ceZ = static_cast<double>(c.z) - e.z;
+	double deX = static_cast<double>(d.x) - e.x;
+	double deY = static_cast<double>(d.y) - e.y;
+	double deZ = static_cast<double>(d.z) - e.z;
+
+	double aeXbeY = aeX * beY, beXaeY = beX * aeY;
+	double beXceY = beX * ceY, ceXbeY = ceX * beY;
+	double ceXdeY = ceX * deY, deXceY = deX * ceY;
+	double deXaeY = deX * aeY, aeXdeY = aeX * deY;
+	double aeXceY = aeX * ceY, ceXaeY = ceX * aeY;
+	double beXdeY = beX * deY, deXbeY = deX * beY;
+
+	double ab = aeXbeY - beXaeY;
+	double bc = beXceY - ceXbeY;
+	double cd = ceXdeY - deXceY;
+	double da = deXaeY - aeXdeY;
+	double ac = aeXceY - ceXaeY;
+	double bd = beXdeY - deXbeY;
+
+	double abc = aeZ * bc - beZ * ac + ceZ * ab;
+	double bcd = beZ * cd - ceZ * bd + deZ * bc;
+	double cda = ceZ * da + deZ * ac + aeZ * cd;
+	double dab = deZ * ab + aeZ * bd + beZ * da;
+
+	double aLift = aeX * aeX + aeY * aeY + aeZ * aeZ;
+	double bLift = beX * beX + beY * beY + beZ * beZ;
+	double cLift = ceX * ceX + ceY * ceY + ceZ * ceZ;
+	double dLift = deX * deX + deY * deY + deZ * deZ;
+
+	double determinant = (aLift * bcd - bLift * cda) + (cLift * dab - dLift * abc);
+
+	//The same sums with every term made positive
+	double abPermanent = std::fabs(aeXbeY) + std::fabs(beXaeY);
+	double bcPermanent = std::fabs(beXceY) + std::fabs(ceXbeY);
+	double cdPermanent = std::fabs(ceXdeY) + std::fabs(deXceY);
+	double daPermanent = std::fabs(deXaeY) + std::fabs(aeXdeY);
+	double acPermanent = std::fabs(aeXceY) + std::fabs(ceXaeY);
+	double bdPermanent = std::fabs(beXdeY) + std::fabs(deXbeY);
+
+	double abcPermanent = std::fabs(aeZ) * bcPermanent + std::fabs(beZ) * acPermanent + std::fabs(ceZ) * abPermanent;
+	double bcdPermanent = std::fabs(beZ) * cdPermanent + std::fabs(ceZ) * bdPermanent + std::fabs(deZ) * bcPermanent;
+	double cdaPermanent = std::fabs(ceZ) * daPermanent + std::fabs(deZ) * acPermanent + std::fabs(aeZ) * cdPermanent;
+	double dabPermanent = std::fabs(deZ) * abPermanent + std::fabs(aeZ) * bdPermanent + std::fabs(beZ) * daPermanent;
+
+	double permanent = (aLift * bcdPermanent + bLift * cdaPermanent) + (cLift * dabPermanent + dLift * abcPermanent);
+
+	double errorBound = INSPHERE_ERROR_BOUND * permanent;
+	if (determinant > errorBound || -determinant > errorBound) return determinant;
+
+	double ae[3], be[3], ce[3], de[3];
+	if (ExactDifference(a, e, ae) && ExactDifference(b, e, be) && ExactDifference(c, e, ce) && ExactDifference(d, e, de)) return ExactInSphere(ae, be, ce, de);
+
+	return ExactInSphere(a, b, c, d, e);
+
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <kmeans_kernels.h>
+
+namespace VoronoiCore {
+
+//k-d tree over the centroids for closest centroid searches in O(log k) - pays off for large palettes
+//Rebuilt whenever the centroids move, a few microseconds for hundreds of centroids, small enough to stay in L1/L2
+//Searches match the brute force search exactly, the lower index wins between equal distances
+class CentroidKdTree {
+
+public:
+
+	CentroidKdTree();
+	~CentroidKdTree();
+
+	void Build(const CentroidTable& centroids);
+
+	//Closest centroid of every pixel - thread safe, neighbouring pixels seed each other's search
+	void Assign(const uint32_t* pixels, size_t pixelCount, uint32_t* assignments) const;
+
+private:
+
+	//Inner nodes split on axis at split, their left child follows them and right holds the right child
+	//Leaves (axis LEAF_AXIS) hold the centroids [first, first + count) of the reordered centroid arrays
+	struct Node {
+
+		uint32_t axis;
+		float split;
+		uint32_t right;
+		uint32_t first;
+		uint32_t count;
+
+	};
+
+	uint32_t BuildNode(uint32_t first, uint32_t count);
+
+	std::vector<Node> m_nodes;
+
+	//Centroids in leaf order and their original indices
+	std::vector<float> m_centroidR;
+	std::vector<float> m_centroidG;
+	std::vector<float> m_centroidB;
+	std::vector<uint32_t> m_centroidIndices;
+
+	//Centroids in index order, seeds the search with the previous pixel's centroid
+	std::vector<float> m_tableR;
+	std::vector<float> m_tableG;
+	std::vector<float> m_tableB;
+
+};
+
+}
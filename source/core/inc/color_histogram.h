@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <color_space.h>
+
+namespace VoronoiCore {
+
+//Weighted histogram of the colors of a 32-bit RGB frame
+//Exact histograms keep every distinct color, binned ones merge colors sharing the top binBits bits of every channel
+//Every entry keeps the channel sums and count of its pixels, so the centroid means match clustering the pixels themselves
+class ColorHistogram {
+
+public:
+
+	ColorHistogram();
+	~ColorHistogram();
+
+	//binBits 0 builds an exact histogram, 1 to 8 a binned one
+	void Build(const uint32_t* pixels, size_t pixelCount, uint32_t binBits);
+
+	//Move the entries to another color space, only the entries are converted - never the pixels
+	//The sums become the converted entry color times the entry count - exact for exact histograms, binned ones stand in the
+	//converted bin mean for the colors of their pixels
+	void ConvertColors(const ColorSpaceConverter& converter);
+
+	size_t GetEntryCount() const;
+	size_t GetPixelCount() const;
+
+	//Sum of the squared [0, 255] channels of every pixel
+	uint64_t GetSquaredNormSum() const;
+
+	//Color standing in for the entry in the centroid search - the rounded mean of its pixels, packed like the frame
+	const uint32_t* GetEntryColors() const;
+	const uint64_t* GetEntrySumsR() const;
+	const uint64_t* GetEntrySumsG() const;
+	const uint64_t* GetEntrySumsB() const;
+	const uint32_t* GetEntryCounts() const;
+
+	//Entry index of every pixel of the frame
+	const uint32_t* GetPixelEntries() const;
+
+private:
+
+	void Clear();
+	uint32_t AddEntry(uint32_t color);
+	void FinishEntries();
+
+	std::vector<uint32_t> m_entryColors;
+	std::vector<uint64_t> m_entrySumsR;
+	std::vector<uint64_t> m_entrySumsG;
+	std::vector<uint64_t> m_entrySumsB;
+	std::vector<uint32_t> m_entryCounts;
+	std::vector<uint32_t> m_pixelEntries;
+	uint64_t m_squaredNormSum;
+
+	//Exact - open addressing table of 24-bit colors (empty slots hold 0xFFFFFFFF) and their entry indices
+	//Binned - dense table of bin entry indices
+	std::vector<uint32_t> m_tableKeys;
+	std::vector<uint32_t> m_tableEntries;
+
+};
+
+}
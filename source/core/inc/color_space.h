@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <voronoi_types.h>
+
+namespace VoronoiCore {
+
+enum ColorSpace {
+
+	COLOR_SPACE_RGB = 0,
+	COLOR_SPACE_OKLAB = 1,
+	COLOR_SPACE_CIELAB = 2
+
+};
+
+//Conversion of sRGB pixels to a perceptual color space, packed like a pixel so every k-means pass runs on them unchanged
+//Lightness goes to the red byte, a and b to the green and blue bytes around 128, all three with the same scale so euclidean
+//distances of the packed colors stay proportional to the color differences of the space
+//OKLab - L in [0, 1] and a, b scaled by 255. CIELAB (D65) - L in [0, 100] and a, b scaled by 1.1
+//The sRGB decoding and the cube roots come from tables, so a conversion is a few lookups and two 3x3 matrices
+class ColorSpaceConverter {
+
+public:
+
+	ColorSpaceConverter(ColorSpace colorSpace);
+	~ColorSpaceConverter();
+
+	ColorSpace GetColorSpace() const;
+
+	//Opaque packed color of the space, the identity for RGB
+	uint32_t EncodePixel(uint32_t pixel) const;
+	void EncodePixels(const uint32_t* pixels, size_t pixelCount, uint32_t* encodedPixels) const;
+
+	//Normalized [0, 1] packed channels of the space back to an opaque sRGB pixel, out of gamut colors are clamped
+	uint32_t DecodeColor(const Point& color) const;
+
+private:
+
+	float Root(float value) const;
+
+	ColorSpace m_colorSpace;
+
+	//Linear light of every sRGB level
+	std::vector<float> m_linearTable;
+
+	//Cube root (OKLab) or the CIELAB f(t) over [0, 1]
+	std::vector<float> m_rootTable;
+
+};
+
+}
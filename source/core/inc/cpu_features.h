@@ -0,0 +1,19 @@
+#pragma once
+
+namespace VoronoiCore {
+
+enum SimdLevel {
+
+	SIMD_LEVEL_SCALAR = 0,
+	SIMD_LEVEL_SSE41 = 1,
+	SIMD_LEVEL_AVX2 = 2,
+	SIMD_LEVEL_NEON = 3
+
+};
+
+//Highest instruction set supported by both the build and the running CPU
+SimdLevel DetectSimdLevel();
+
+const char* GetSimdLevelName(SimdLevel simdLevel);
+
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <voronoi_types.h>
+
+namespace VoronoiCore {
+
+//Tetrahedron slot of a DelaunayTriangulation - positively oriented vertex indices and the neighbour across the face opposite every
+//vertex, NO_TETRAHEDRON on the outer faces of the super tetrahedron. Free slots have NO_VERTEX vertices
+struct DelaunayTetrahedron {
+
+	int32_t vertices[4];
+	int32_t neighbors[4];
+
+};
+
+//Incremental Delaunay triangulation (Bowyer-Watson) of 3D points with neighbour links
+//Every point is located by a visibility walk from the tetrahedron of the previous one, in Z-order so the walks stay short, its cavity
+//grows breadth first over the neighbours of the containing tetrahedron and the freed slots are reused by the next insertions
+class DelaunayTriangulation {
+
+public:
+
+	static constexpr int32_t NO_VERTEX = -1;
+	static constexpr int32_t NO_TETRAHEDRON = -1;
+
+	DelaunayTriangulation();
+	~DelaunayTriangulation();
+
+	//Points are expected in the unit cube, the super tetrahedron holds the circumsphere of the cube in its insphere
+	//Duplicates of an inserted point and points outside the super tetrahedron are left out
+	void Build(const Point* points, uint32_t pointCount);
+
+	//Vertices are the points followed by the four super tetrahedron vertices
+	uint32_t GetPointCount() const;
+	const std::vector<Point>& GetVertices() const;
+	bool IsSuperVertex(int32_t vertex) const;
+	bool IsInserted(uint32_t point) const;
+	uint32_t GetInsertedCount() const;
+
+	//Tetrahedron slots, free ones included
+	const std::vector<DelaunayTetrahedron>& GetTetrahedrons() const;
+	bool IsFree(int32_t tetrahedron) const;
+	uint32_t GetTetrahedronCount() const;
+
+	//Tetrahedron containing the point, walking from start - NO_TETRAHEDRON outside the super tetrahedron
+	int32_t Locate(const Point& point, int32_t start) const;
+
+	//Move an inserted point - in place when the tetrahedrons around it stay positively oriented and their faces locally Delaunay,
+	//otherwise the point is removed, its hole filled with the Delaunay tetrahedrons of the points around it and the point inserted again
+	//False when co-spherical points around the hole leave no consistent fill or the point cannot be inserted again, the
+	//triangulation then has to be built again
+	bool MovePoint(uint32_t point, const Point& position);
+
+private:
+
+	//Cavity face - the new tetrahedron replaces vertex face of tetrahedron with the inserted point, outside is across the face
+	struct CavityFace {
+
+		int32_t tetrahedron;
+		int32_t face;
+		int32_t outside;
+
+	};
+
+	//Face of the hole a removed vertex leaves, keyed by its sorted vertices - the tetrahedron that held the vertex and the vertex's
+	//index in it, the tetrahedron outside the face and the tetrahedron of the hole triangulation filling the hole behind it
+	struct HoleFace {
+
+		uint64_t key;
+		int32_t tetrahedron;
+		int32_t face;
+		int32_t outside;
+		int32_t fill;
+		int32_t fillFace;
+
+	};
+
+	//Face of a new tetrahedron around the inserted point, keyed by the cavity edge it shares with the next new tetrahedron
+	struct CavityEdge {
+
+		uint64_t key;
+		int32_t tetrahedron;
+		int32_t face;
+
+	};
+
+	//Orientation of the tetrahedron with the vertex opposite face moved to the point - negative when the point lies beyond the face
+	double FaceOrientation(int32_t tetrahedron, int32_t face, const Point& point) const;
+
+	//Positive when the point lies inside the circumsphere of the tetrahedron
+	double InSphere(int32_t tetrahedron, const Point& point) const;
+
+	void Triangulate(const Point* points, uint32_t pointCount, float halfSide);
+	bool HasVertex(int32_t tetrahedron, int32_t vertex) const;
+	bool HasSuperVertex(int32_t tetrahedron) const;
+	bool IsLocallyDelaunay(int32_t tetrahedron, int32_t face) const;
+	bool Insert(int32_t vertex);
+	bool IsInCavity(int32_t tetrahedron) const;
+	void AddToCavity(int32_t tetrahedron);
+	bool FindCavityBoundary(const Point& point);
+	void CollectStar(int32_t vertex, int32_t start);
+	bool RemoveVertex(int32_t vertex);
+	int32_t FindHoleFace(int32_t a, int32_t b, int32_t c) const;
+	int32_t AllocateTetrahedron();
+	void FreeTetrahedron(int32_t tetrahedron);
+
+	uint32_t m_pointCount;
+	std::vector<Point> m_vertices;
+	std::vector<uint8_t> m_isInserted;
+	uint32_t m_insertedCount;
+
+	//A tetrahedron of every vertex, the search for the tetrahedrons around a moved point starts there
+	std::vector<int32_t> m_vertexTetrahedrons;
+
+	std::vector<DelaunayTetrahedron> m_tetrahedrons;
+	std::vector<int32_t> m_freeTetrahedrons;
+	int32_t m_lastTetrahedron;
+
+	//Insertion scratch - cavity tetrahedrons are stamped with the insertion they belong to, a move stamps the tetrahedrons around the point
+	std::vector<uint32_t> m_cavityStamps;
+	uint32_t m_cavityStamp;
+	std::vector<int32_t> m_cavity;
+	std::vector<CavityFace> m_cavityFaces;
+	std::vector<CavityEdge> m_cavityEdges;
+	std::vector<uint64_t> m_insertionOrder;
+
+	//Removal scratch - the points around a removed vertex are triangulated on their own, the tetrahedrons of that triangulation
+	//inside the hole are copied into it. Created on the first removal, a hole triangulation has no hole triangulation of its own
+	std::unique_ptr<DelaunayTriangulation> m_holeTriangulation;
+	std::vector<int32_t> m_linkVertices;
+	std::vector<Point> m_linkPoints;
+	std::vector<HoleFace> m_holeFaces;
+	std::vector<int32_t> m_fill;
+	std::vector<int32_t> m_fillIndices;
+	std::vector<int32_t> m_fillTetrahedrons;
+
+};
+
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <voronoi_types.h>
+
+//Orientation and in-sphere predicates with exact signs for any float input
+//Evaluated in double first, a result smaller than the error bound of that evaluation is evaluated again in exact expansion arithmetic
+//(Shewchuk, Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates), so only near-degenerate inputs
+//pay for the exact path. The sign of the returned value is exact, its magnitude is an approximation
+
+namespace VoronoiCore {
+
+//Positive when d lies on the side of the plane through a, b, c that (b - a) x (c - a) points to, zero when the points are coplanar
+double Orient3d(const Point& a, const Point& b, const Point& c, const Point& d);
+
+//Positive when e lies inside the circumsphere of the positively oriented a, b, c, d, zero when the points are cospherical
+double InSphere(const Point& a, const Point& b, const Point& c, const Point& d, const Point& e);
+
+}
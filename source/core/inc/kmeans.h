@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <centroid_kd_tree.h>
+#include <color_histogram.h>
+#include <color_space.h>
+#include <cpu_features.h>
+#include <kmeans_bounds.h>
+#include <kmeans_convergence.h>
+#include <kmeans_kernels.h>
+#include <kmeans_mini_batch.h>
+#include <kmeans_seeding.h>
+#include <palette_lut.h>
+#include <task_scheduler.h>
+#include <voronoi_types.h>
+
+namespace VoronoiCore {
+
+//Unpack a 0xAARRGGBB pixel into normalized [0, 1] channels
+inline Point UnpackPixel(uint32_t pixel) {
+
+	return Point(
+		static_cast<float>((pixel >> 16) & 0xFF) / 255.0f,
+		static_cast<float>((pixel >> 8) & 0xFF) / 255.0f,
+		static_cast<float>(pixel & 0xFF) / 255.0f
+	);
+
+}
+
+//Pack normalized [0, 1] channels into an opaque 0xFFRRGGBB pixel
+inline uint32_t PackPixel(const Point& color) {
+
+	uint32_t pixel = uint32_t(0xFF) << 24;
+	pixel = pixel + (static_cast<uint32_t>(static_cast<uint8_t>(color.x * 255.0f)) << 16);
+	pixel = pixel + (static_cast<uint32_t>(static_cast<uint8_t>(color.y * 255.0f)) << 8);
+	pixel = pixel + static_cast<uint32_t>(static_cast<uint8_t>(color.z * 255.0f));
+
+	return pixel;
+
+}
+
+//CPU k-means color clustering of 32-bit RGB frames
+class KMeans {
+
+public:
+
+	//Frame passes are spread over the scheduler's threads, a null scheduler runs them on the calling thread
+	KMeans(uint32_t centroidCount, TaskScheduler* taskScheduler);
+	~KMeans();
+
+	//Uniform random centroids
+	void ResetCentroids();
+
+	//Centroids seeded from the colors of a frame - see KMeansSeeder
+	void SeedCentroids(const uint32_t* pixels, size_t pixelCount, SeedingMethod method);
+	void SeedCentroids(const ColorHistogram& histogram, SeedingMethod method);
+
+	//Seed of the random generators behind ResetCentroids, SeedCentroids and the mini-batches
+	void SetRandomSeed(uint64_t seed);
+
+	void QuantizeFrame(const uint32_t* pixels, size_t pixelCount, uint32_t* quantizedPixels) const;
+	void UpdateCentroids(const uint32_t* pixels, size_t pixelCount);
+	void QuantizeFrameAndUpdateCentroids(const uint32_t* pixels, size_t pixelCount, uint32_t* quantizedPixels);
+
+	//Iterations over the weighted colors of a frame - same centroids as the pixel versions for exact histograms
+	void UpdateCentroids(const ColorHistogram& histogram);
+	void QuantizeFrameAndUpdateCentroids(const ColorHistogram& histogram, uint32_t* quantizedPixels);
+
+	//batchCount mini-batch updates from pixels sampled out of the frame - a fraction of the cost of a full iteration on large frames,
+	//the frame itself is only assigned by QuantizeFrame. The statistics only measure the centroid shift over the batches
+	void UpdateCentroidsMiniBatch(const uint32_t* pixels, size_t pixelCount, uint32_t batchCount);
+	void SetMiniBatchSettings(const MiniBatchSettings& settings);
+	const MiniBatchSettings& GetMiniBatchSettings() const;
+
+	uint32_t GetCentroidCount() const;
+	const Point* GetCentroids() const;
+	void SetCentroids(const Point* centroids);
+	SimdLevel GetSimdLevel() const;
+
+	//Palette resizing from the clusters of the current centroids over a histogram - the centroid count changes and the next
+	//iterations start without bounds. SplitCentroids splits up to splitCount of the clusters with the largest squared errors in
+	//two along their widest channel, single color clusters are never split
+	//MergeCentroids merges the cheapest pair of clusters (Ward's criterion - the squared error the merge adds) as long as the
+	//added error stays within maxInertiaIncrease and more than minCentroidCount centroids are left, empty clusters merge at no cost
+	//Both return the number of centroids added or removed
+	uint32_t SplitCentroids(const ColorHistogram& histogram, uint32_t splitCount);
+	uint32_t MergeCentroids(const ColorHistogram& histogram, double maxInertiaIncrease, uint32_t minCentroidCount);
+
+	//Brute force by default - the bounded algorithms speed up repeated iterations over the same frame,
+	//the k-d tree searches of large palettes
+	void SetAlgorithm(KMeansAlgorithm algorithm);
+	KMeansAlgorithm GetAlgorithm() const;
+
+	//Space the centroids live in - the frames and histograms given to the k-means must be converted to it (see ColorSpaceConverter
+	//and ColorHistogram::ConvertColors), the quantized pixels are always written back in sRGB
+	void SetColorSpace(ColorSpace colorSpace);
+	ColorSpace GetColorSpace() const;
+
+	//Brute force and QuantizeFrame searches on fixed point centroids with the integer kernel - centroids are rounded to 1/128
+	//of a channel step, so near ties may go to another centroid than with the float kernel
+	void SetFixedPointAssignment(bool isFixedPoint);
+	bool IsFixedPointAssignment() const;
+
+	//Drop the distance bounds, needed when a new frame is written over the buffer of the previous one
+	void InvalidateBounds();
+
+	//Centroid shift, reassigned pixels, inertia and repaired clusters of the last UpdateCentroids/QuantizeFrameAndUpdateCentroids
+	const IterationStatistics& GetIterationStatistics() const;
+
+	//Tabulate the closest centroid of every RGB color for QuantizeFrame, gridBits per channel (5 or 6)
+	//The table is dropped as soon as the centroids move
+	void BuildPaletteLut(uint32_t gridBits);
+	bool IsPaletteLutBuilt() const;
+
+private:
+
+	//Integer channel sums in [0, 255] units - exact for any frame size and in any reduction order
+	struct CentroidSums {
+
+		std::vector<uint64_t> r;
+		std::vector<uint64_t> g;
+		std::vector<uint64_t> b;
+		std::vector<uint32_t> count;
+
+		//Squared [0, 255] channels and reassigned pixels of the band
+		uint64_t squaredNorm;
+		uint64_t reassignedCount;
+
+	};
+
+	//Pixel counts, channel sums and channel sums of squares of the clusters in [0, 255] units
+	struct ClusterMoments {
+
+		std::vector<double> count;
+		std::vector<double> r;
+		std::vector<double> g;
+		std::vector<double> b;
+		std::vector<double> squaredR;
+		std::vector<double> squaredG;
+		std::vector<double> squaredB;
+
+	};
+
+	size_t SplitBands(size_t itemCount, size_t* bandSize) const;
+	void RunBands(size_t bandCount, const std::function<void(uint32_t)>& band) const;
+	void AssignFrame(const uint32_t* pixels, size_t pixelCount, uint32_t* quantizedPixels, std::vector<CentroidSums>* bandSums, KMeansBounds* bounds,
+		const ColorHistogram* histogram, uint32_t* previousAssignments) const;
+	void AssignAndMoveCentroids(const uint32_t* pixels, size_t pixelCount, uint32_t* quantizedPixels, const ColorHistogram* histogram);
+	void MoveCentroidsToMeans(const uint32_t* pixels, size_t pixelCount, const ColorHistogram* histogram);
+	void MoveCentroidsTowardsBatchMeans();
+	void InvalidateAssignments();
+	void UpdateCentroidTable();
+	void MeasureClusters(const uint32_t* pixels, size_t pixelCount, const ColorHistogram* histogram);
+	std::vector<uint32_t> FindLargestClusters(uint32_t clusterCount) const;
+	void SplitCluster(uint32_t clusterIndex, uint32_t newClusterIndex);
+	uint32_t RepairEmptyClusters(const uint32_t* pixels, size_t pixelCount, const ColorHistogram* histogram);
+	void ResizeCentroids(uint32_t centroidCount);
+
+	std::vector<Point> m_centroids;
+	std::unique_ptr<KMeansSeeder> m_seeder;
+
+	//Assignment kernel picked from the CPU features, centroids mirrored in its layout
+	SimdLevel m_simdLevel;
+	AssignKernel m_assignKernel;
+	std::vector<float> m_centroidTableR;
+	std::vector<float> m_centroidTableG;
+	std::vector<float> m_centroidTableB;
+	std::vector<uint32_t> m_centroidPixels;
+
+	//Decodes the centroids to their sRGB pixels
+	std::unique_ptr<ColorSpaceConverter> m_colorSpaceConverter;
+
+	//Integer kernel and the centroids in its fixed point layout
+	bool m_isFixedPointAssignment;
+	AssignFixedKernel m_assignFixedKernel;
+	std::vector<uint32_t> m_fixedCentroidTableRB;
+	std::vector<uint32_t> m_fixedCentroidTableG;
+
+	//Frame bands run as scheduler tasks, every band accumulates into its own sums
+	TaskScheduler* m_taskScheduler;
+	std::vector<CentroidSums> m_bandCentroidSums;
+
+	//Triangle inequality bounds of the Hamerly/Elkan algorithms, the previous table lets them follow the centroid moves
+	KMeansAlgorithm m_algorithm;
+	std::unique_ptr<KMeansBounds> m_bounds;
+	std::vector<float> m_previousCentroidTableR;
+	std::vector<float> m_previousCentroidTableG;
+	std::vector<float> m_previousCentroidTableB;
+
+	//k-d tree over the current centroids, kept up to date while it is the selected algorithm
+	std::unique_ptr<CentroidKdTree> m_kdTree;
+
+	//Closest centroid lookups of the current centroids, built on request
+	std::unique_ptr<PaletteLut> m_paletteLut;
+
+	//Assignments of the previous iteration over the same frame, to count the reassigned pixels
+	std::vector<uint32_t> m_previousAssignments;
+	bool m_arePreviousAssignmentsValid;
+	IterationStatistics m_iterationStatistics;
+
+	//Quantized color of every histogram entry
+	std::vector<uint32_t> m_entryQuantizedPixels;
+
+	//Clusters measured for the palette resizing and the empty cluster repairs, and the assignments they come from
+	ClusterMoments m_clusterMoments;
+	std::vector<uint32_t> m_entryAssignments;
+
+	//Mini-batch pixels and the pixels every centroid was moved towards since the assignments were last invalidated
+	MiniBatchSettings m_miniBatchSettings;
+	std::unique_ptr<MiniBatchSampler> m_miniBatchSampler;
+	std::vector<uint32_t> m_miniBatchPixels;
+	std::vector<uint64_t> m_miniBatchCounts;
+
+};
+
+}
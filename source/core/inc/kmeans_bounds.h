@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <kmeans_kernels.h>
+
+namespace VoronoiCore {
+
+enum KMeansAlgorithm {
+
+	KMEANS_ALGORITHM_BRUTE_FORCE = 0,
+	KMEANS_ALGORITHM_HAMERLY = 1,
+	KMEANS_ALGORITHM_ELKAN = 2,
+	KMEANS_ALGORITHM_KD_TREE = 3
+
+};
+
+//Per-pixel distance bounds for triangle inequality accelerated k-means iterations over the same frame
+//Hamerly keeps one lower bound per pixel, Elkan one per pixel and centroid - pixels whose bounds prove the assigned
+//centroid is still the closest skip the distance computations, the assignments match the brute force search
+//Elkan skips more searches but its bounds take pixelCount * centroidCount floats of memory traffic per pass
+class KMeansBounds {
+
+public:
+
+	KMeansBounds(uint32_t centroidCount, SimdLevel simdLevel);
+	~KMeansBounds();
+
+	//Forget the bounds - the next pass searches every pixel in full
+	void Invalidate();
+
+	//Ready the bounds for a pass over pixels with the given centroids - not thread safe
+	//algorithm is KMEANS_ALGORITHM_HAMERLY or KMEANS_ALGORITHM_ELKAN
+	void BeginPass(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, KMeansAlgorithm algorithm);
+
+	//Assign a block of the frame, bands of the pass may run on different threads
+	//Returns the closest centroid of every pixel of the block
+	const uint32_t* AssignBlock(size_t blockStart, size_t blockSize, const CentroidTable& centroids);
+
+	//Move the bounds along with the centroids after the pass - not thread safe
+	void EndPass(const CentroidTable& previousCentroids, const CentroidTable& centroids);
+
+	KMeansAlgorithm GetAlgorithm() const;
+
+private:
+
+	void AssignBlockHamerly(size_t blockStart, size_t blockSize, const CentroidTable& centroids);
+	void AssignBlockElkan(size_t blockStart, size_t blockSize, const CentroidTable& centroids);
+
+	uint32_t m_centroidCount;
+
+	//Pixels whose bounds fail are searched in full in batches by the SIMD kernel
+	AssignTwoNearestKernel m_assignTwoNearestKernel;
+
+	KMeansAlgorithm m_algorithm;
+	bool m_areBoundsValid;
+	const uint32_t* m_pixels;
+	size_t m_pixelCount;
+
+	//Per pixel - assigned centroid, upper bound of its distance and lower bound(s) of the other distances
+	std::vector<uint32_t> m_pixelAssignments;
+	std::vector<float> m_pixelUpperBounds;
+	std::vector<float> m_pixelLowerBounds;
+
+	//Per centroid - distance moved in the last update, applied to the bounds lazily during the next pass
+	std::vector<float> m_centroidDrift;
+	uint32_t m_maxDriftIndex;
+	float m_maxDrift;
+	float m_secondMaxDrift;
+
+	//Centroid to centroid distances and half the distance to the closest other centroid
+	std::vector<float> m_centroidDistances;
+	std::vector<float> m_centroidHalfMinDistances;
+
+};
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+
+namespace VoronoiCore {
+
+//Measurements of one k-means iteration, negative values were not measured
+struct IterationStatistics {
+
+	//Largest centroid move, in normalized [0, 1] channels
+	float maxCentroidShift;
+
+	//Fraction of the pixels whose closest centroid changed
+	float reassignedRatio;
+
+	//Sum of the squared [0, 255] distances of the pixels to the means of their clusters
+	double inertia;
+
+	//Empty clusters whose centroids were moved into the clusters with the largest errors
+	uint32_t repairedClusterCount;
+
+};
+
+//Any criterion met stops the iterations of a frame, non-positive tolerances are ignored
+struct ConvergenceTolerance {
+
+	float maxCentroidShift;
+	float reassignedRatio;
+
+	//Relative inertia drop of an iteration
+	float inertiaDelta;
+
+	//Iterations run at most per frame
+	uint32_t maxIterationCount;
+
+};
+
+//Decides when the k-means iterations of a frame have converged and keeps the iteration counts of the finished frames
+class ConvergenceMonitor {
+
+public:
+
+	ConvergenceMonitor(const ConvergenceTolerance& tolerance);
+	~ConvergenceMonitor();
+
+	//Start a new frame
+	void Reset();
+
+	void AddIteration(const IterationStatistics& statistics);
+
+	//Keep iterating a finished frame whose centroids were changed from outside, e.g. a palette resize - convergence and the iteration
+	//limit start over, the frame is counted with all its iterations once it finishes again
+	void ContinueFrame();
+
+	//Converged, or out of iterations - the frame is finished
+	bool HasConverged() const;
+	bool IsFinished() const;
+
+	//Iterations of the frame, over all its continuations
+	uint32_t GetIterationCount() const;
+	const IterationStatistics& GetLastStatistics() const;
+
+	//Empty clusters repaired over the iterations of the frame
+	uint32_t GetRepairedClusterCount() const;
+
+	//Frames finished since construction and their iteration counts
+	uint64_t GetFinishedFrameCount() const;
+	uint32_t GetLastFrameIterationCount() const;
+	double GetAverageIterationCount() const;
+
+private:
+
+	ConvergenceTolerance m_tolerance;
+
+	uint32_t m_iterationCount;
+	uint32_t m_continuedIterationCount;
+	uint32_t m_repairedClusterCount;
+	IterationStatistics m_lastStatistics;
+	double m_previousInertia;
+	bool m_hasConverged;
+	bool m_isFrameCounted;
+
+	uint64_t m_finishedFrameCount;
+	uint64_t m_finishedIterationCount;
+	uint32_t m_lastFrameIterationCount;
+
+};
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <cpu_features.h>
+
+//Nearest centroid assignment kernels
+//Kept free of inline functions and templates - the SIMD translation units are built with wider instruction sets
+//and must not emit shared symbols the scalar code could end up linking against, their templates stay in anonymous namespaces
+//Palettes of 8, 16, 32, 64, 128 and 256 centroids run kernels instantiated for that count, so the centroid loop has a
+//compile-time trip count the compiler can unroll, other counts run the same kernels with the count read from the table
+
+namespace VoronoiCore {
+
+//Centroids in structure of arrays layout with channels scaled to [0, 255] - the pixel channels are compared unscaled
+struct CentroidTable {
+
+	const float* r;
+	const float* g;
+	const float* b;
+	uint32_t count;
+
+};
+
+//Fractional bits of the fixed point centroids - 8.7 keeps channel differences in 16 bits and the squared distances in 32 bits unsigned
+const uint32_t FIXED_CENTROID_FRACTION_BITS = 7;
+
+//Centroids in fixed point, every channel rounded to [0, 255 << FIXED_CENTROID_FRACTION_BITS]
+//rb packs blue in the low and red in the high 16 bits - the layout of a pixel masked with 0x00FF00FF - so one 32-bit broadcast
+//fills both 16-bit lanes the pixel pair is subtracted from
+struct FixedCentroidTable {
+
+	const uint32_t* rb;
+	const uint32_t* g;
+	uint32_t count;
+
+};
+
+//Write the index of the closest centroid (squared euclidean distance, first one on ties) of every pixel to assignments
+typedef void (*AssignKernel)(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments);
+
+//Same as AssignKernel, also writes the squared distances to the closest and the second closest centroid
+typedef void (*AssignTwoNearestKernel)(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments,
+	float* minDistances, float* secondMinDistances);
+
+//Same as AssignKernel on fixed point centroids - integer differences and distances straight from the packed pixel bytes
+typedef void (*AssignFixedKernel)(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments);
+
+void AssignScalar(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments);
+void AssignTwoNearestScalar(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments,
+	float* minDistances, float* secondMinDistances);
+void AssignFixedScalar(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments);
+
+#if defined(VORONOI_CORE_X86)
+void AssignSSE41(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments);
+void AssignTwoNearestSSE41(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments,
+	float* minDistances, float* secondMinDistances);
+void AssignFixedSSE41(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments);
+void AssignAVX2(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments);
+void AssignTwoNearestAVX2(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments,
+	float* minDistances, float* secondMinDistances);
+void AssignFixedAVX2(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments);
+#endif
+
+#if defined(VORONOI_CORE_NEON)
+void AssignNEON(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments);
+void AssignTwoNearestNEON(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments,
+	float* minDistances, float* secondMinDistances);
+void AssignFixedNEON(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments);
+#endif
+
+AssignKernel GetAssignKernel(SimdLevel simdLevel);
+AssignTwoNearestKernel GetAssignTwoNearestKernel(SimdLevel simdLevel);
+AssignFixedKernel GetAssignFixedKernel(SimdLevel simdLevel);
+
+}
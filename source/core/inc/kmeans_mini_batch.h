@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <random_generator.h>
+
+namespace VoronoiCore {
+
+enum MiniBatchSampling {
+
+	MINI_BATCH_SAMPLING_RANDOM = 0,
+	MINI_BATCH_SAMPLING_STRIDED = 1
+
+};
+
+//Mini-batch k-means - every update moves the centroids towards the means of their pixels in a small batch sampled from the frame
+//The learning rate of a centroid is the share of its pixels so far that came from the batch, so it settles on the mean of all of them,
+//minLearningRate keeps it from dropping below a floor
+struct MiniBatchSettings {
+
+	uint32_t batchSize;
+	MiniBatchSampling sampling;
+	float minLearningRate;
+
+};
+
+//Batches of pixels sampled from a frame
+//Random - independent uniform picks, strided - every stride-th pixel from a random start, one pass over memory in order
+class MiniBatchSampler {
+
+public:
+
+	MiniBatchSampler(uint64_t seed);
+	~MiniBatchSampler();
+
+	void SetSeed(uint64_t seed);
+
+	//Copy batchSize pixels of the frame to batchPixels, batches of whole frames are strided whatever the sampling
+	void Sample(MiniBatchSampling sampling, const uint32_t* pixels, size_t pixelCount, size_t batchSize, uint32_t* batchPixels);
+
+private:
+
+	RandomGenerator m_random;
+
+};
+
+}
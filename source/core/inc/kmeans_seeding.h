@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <random_generator.h>
+#include <task_scheduler.h>
+#include <voronoi_types.h>
+
+namespace VoronoiCore {
+
+enum SeedingMethod {
+
+	SEEDING_METHOD_UNIFORM = 0,
+	SEEDING_METHOD_KMEANS_PLUS_PLUS = 1,
+	SEEDING_METHOD_KMEANS_PARALLEL = 2,
+	SEEDING_METHOD_MEDIAN_CUT = 3
+
+};
+
+//Initial k-means centroids picked from the colors of a frame
+//Uniform - random points of the unit RGB cube, blind to the frame
+//k-means++ - D^2 sampling, every next centroid is drawn with probability proportional to its squared distance to the chosen ones
+//k-means|| - D^2 sampling of a few rounds of oversampled candidates in parallel, reduced to the centroids by weighted k-means++
+//Median cut - recursive splits of the heaviest color box at the weighted median of its longest channel
+//Large inputs are first subsampled proportionally to their weights, the result only depends on the seed
+class KMeansSeeder {
+
+public:
+
+	//The candidate passes of k-means|| run on the scheduler's threads, a null scheduler runs them on the calling thread
+	KMeansSeeder(uint64_t seed, TaskScheduler* taskScheduler);
+	~KMeansSeeder();
+
+	void SetSeed(uint64_t seed);
+
+	//Centroids in normalized [0, 1] channels
+	void SeedUniform(uint32_t centroidCount, Point* centroids);
+
+	//colors are packed like the frame, null weights weigh every color 1
+	void Seed(SeedingMethod method, const uint32_t* colors, const uint32_t* weights, size_t colorCount, uint32_t centroidCount, Point* centroids);
+
+private:
+
+	//Weighted colors in [0, 255] channels
+	struct ColorSet {
+
+		std::vector<float> r;
+		std::vector<float> g;
+		std::vector<float> b;
+		std::vector<double> weight;
+
+		void Clear();
+		void Add(float colorR, float colorG, float colorB, double colorWeight);
+		size_t GetCount() const;
+
+	};
+
+	void SampleColors(const uint32_t* colors, const uint32_t* weights, size_t colorCount);
+	void SeedKMeansPlusPlus(const ColorSet& colors, uint32_t centroidCount, Point* centroids);
+	void SeedKMeansParallel(uint32_t centroidCount, Point* centroids);
+	void SeedMedianCut(uint32_t centroidCount, Point* centroids);
+	void RunBlocks(size_t itemCount, const std::function<void(size_t, size_t)>& block) const;
+
+	RandomGenerator m_random;
+	TaskScheduler* m_taskScheduler;
+
+	ColorSet m_samples;
+	ColorSet m_candidates;
+	std::vector<double> m_sampleDistances;
+	std::vector<uint32_t> m_sampleNearest;
+	std::vector<uint32_t> m_sampleOrder;
+
+};
+
+}
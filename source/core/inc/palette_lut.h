@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <kmeans_kernels.h>
+
+namespace VoronoiCore {
+
+//3D lookup table from RGB to the index of the closest centroid
+//Cells lying inside one voronoi cell store that centroid, cells crossed by voronoi faces store the few centroids
+//that can win inside them and are searched per pixel - lookups match the brute force search exactly
+class PaletteLut {
+
+public:
+
+	PaletteLut();
+	~PaletteLut();
+
+	//gridBits per channel, 5 builds a 32x32x32 table, 6 a 64x64x64 one
+	void Build(const CentroidTable& centroids, uint32_t gridBits);
+	bool IsBuilt() const;
+	void Clear();
+
+	//Closest centroid of every pixel
+	void Assign(const uint32_t* pixels, size_t pixelCount, uint32_t* assignments) const;
+
+	//Fraction of the cells crossed by voronoi faces
+	float GetBoundaryCellRatio() const;
+
+private:
+
+	uint32_t m_gridBits;
+	std::vector<float> m_centroidR;
+	std::vector<float> m_centroidG;
+	std::vector<float> m_centroidB;
+
+	//Centroid index, or BOUNDARY_CELL | offset into m_candidates where the candidate count and the candidates follow
+	std::vector<uint32_t> m_cells;
+	std::vector<uint32_t> m_candidates;
+	size_t m_boundaryCellCount;
+
+};
+
+}
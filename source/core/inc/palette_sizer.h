@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+#include <color_histogram.h>
+#include <kmeans.h>
+
+namespace VoronoiCore {
+
+//Adaptive palette size - the palette grows while the frame is over its error budget and shrinks while merging clusters keeps it under
+//The error is the mean squared error per channel in [0, 255] units of the clustering color space
+struct PaletteSizeSettings {
+
+	uint32_t minCentroidCount;
+	uint32_t maxCentroidCount;
+	float targetMeanSquaredError;
+
+};
+
+//Mean squared error per channel of 8-bit channels at a PSNR in dB
+float PsnrToMeanSquaredError(float psnr);
+
+//Picks the palette size of every frame between the k-means iterations
+//Splits only happen over the budget and merges only while the merged palette stays within it, so the size never oscillates
+class PaletteSizer {
+
+public:
+
+	PaletteSizer(const PaletteSizeSettings& settings);
+	~PaletteSizer();
+
+	//Called once the iterations of a frame over the histogram finished - splits the worst clusters of a palette over the budget, merges the
+	//closest ones of a palette under it. True when the palette changed and needs more iterations
+	bool Update(KMeans& kmeans, const ColorHistogram& histogram);
+
+	//Mean squared error per channel of the palette last given to Update, -1 before the first one
+	float GetLastMeanSquaredError() const;
+
+private:
+
+	PaletteSizeSettings m_settings;
+	float m_lastMeanSquaredError;
+
+};
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <voronoi_types.h>
+
+namespace VoronoiCore {
+
+//Orders the edges of a polygon into a loop of vertices without scanning and erasing the edges left - the endpoints of undirected
+//edges are sorted once and every step finds the next edge by binary search, directed edges are walked through a next vertex table
+class PolygonChainer {
+
+public:
+
+	PolygonChainer();
+	~PolygonChainer();
+
+	//Vertices along the edges starting with edges[0].a then edges[0].b, every edge taken once
+	//Returns false when the edges do not close into a single loop, loop then holds the vertices chained so far
+	bool Chain(const EdgeIndex* edges, uint32_t edgeCount, std::vector<uint32_t>* loop);
+
+	//Same for edges directed along the loop between vertices below vertexCount - a walk over a table of the next vertices
+	bool ChainDirected(const EdgeIndex* edges, uint32_t edgeCount, uint32_t vertexCount, std::vector<uint32_t>* loop);
+
+private:
+
+	//Vertex in the high half, edge index in the low half
+	std::vector<uint64_t> m_endpoints;
+	std::vector<uint8_t> m_isChained;
+
+	std::vector<uint32_t> m_nextVertices;
+
+};
+
+}
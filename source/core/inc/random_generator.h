@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+namespace VoronoiCore {
+
+//PCG32 pseudo random generator - small, fast and the same sequence for the same seed on every platform
+class RandomGenerator {
+
+public:
+
+	RandomGenerator(uint64_t seed);
+	~RandomGenerator();
+
+	void SetSeed(uint64_t seed);
+
+	uint32_t NextUInt32();
+	uint64_t NextUInt64();
+
+	//Uniform in [0, 1)
+	float NextFloat();
+	double NextDouble();
+
+private:
+
+	uint64_t m_state;
+	uint64_t m_increment;
+
+};
+
+//Uniform [0, 1) value from a seed and an index - random draws that do not depend on the thread they run on
+double HashToUnitDouble(uint64_t seed, uint64_t index);
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <color_histogram.h>
+
+namespace VoronoiCore {
+
+//Scene cut detection between consecutive frames from their coarse color distributions
+//The distance is the total variation distance of the pixel fractions in binBits per channel bins - 0 for the same
+//distribution, 1 for frames without a color bin in common
+class SceneCutDetector {
+
+public:
+
+	SceneCutDetector(uint32_t binBits, float cutDistance);
+	~SceneCutDetector();
+
+	//Forget the previous frame, the next one is a cut
+	void Reset();
+
+	//Compare the frame with the previous one and keep it for the next call, true on a scene cut
+	bool Update(const ColorHistogram& histogram);
+
+	//Same from a regular sample of the frame pixels, for frames without a histogram
+	bool Update(const uint32_t* pixels, size_t pixelCount);
+
+	//Distance of the last Update, 1 when there was no previous frame
+	float GetLastDistance() const;
+
+private:
+
+	uint32_t GetBin(uint32_t color) const;
+	bool CompareWithPreviousFrame();
+
+	uint32_t m_binBits;
+	float m_cutDistance;
+	float m_lastDistance;
+	bool m_hasPreviousFrame;
+
+	std::vector<float> m_binFractions;
+	std::vector<float> m_previousBinFractions;
+
+};
+
+}
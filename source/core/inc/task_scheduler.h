@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace VoronoiCore {
+
+//Long-lived work-stealing task scheduler
+//Every worker owns a deque - it runs its own tasks newest first and steals the oldest tasks of the other workers when empty
+class TaskScheduler {
+
+public:
+
+	//threadCount 0 uses every hardware thread
+	TaskScheduler(uint32_t threadCount);
+	~TaskScheduler();
+	uint32_t GetThreadCount() const;
+
+	//Queue a job and return the future of its result
+	template <typename Function>
+	std::future<typename std::invoke_result<Function>::type> Submit(Function function);
+
+	//Run task(taskIndex) for every taskIndex in [0, taskCount) and wait for all of them
+	//The calling thread runs tasks too, so it can be called from inside a submitted job
+	void ParallelFor(uint32_t taskCount, const std::function<void(uint32_t)>& task);
+
+private:
+
+	//Lives on the stack of the ParallelFor call, which waits until every runner pushed for it has finished
+	struct ParallelForState {
+
+		const std::function<void(uint32_t)>* task;
+		uint32_t taskCount;
+		std::atomic<uint32_t> nextIndex;
+		std::atomic<uint32_t> doneCount;
+		std::atomic<uint32_t> finishedRunnerCount;
+
+	};
+
+	//Either a submitted job or a runner of a ParallelFor call, runners are pushed without allocating
+	struct QueuedTask {
+
+		std::function<void()> function;
+		ParallelForState* parallelFor;
+
+	};
+
+	//Ring buffer that only grows - a deque allocates and frees blocks while its size moves around a block boundary
+	struct WorkerQueue {
+
+		WorkerQueue();
+		bool IsEmpty() const;
+		void PushBack(QueuedTask task);
+		QueuedTask PopBack();
+		QueuedTask PopFront();
+
+		std::mutex mutex;
+		std::vector<QueuedTask> tasks;
+		size_t first;
+		size_t count;
+
+	};
+
+	static void RunParallelFor(ParallelForState& state);
+	void Push(QueuedTask task);
+	bool TryRunTask(uint32_t queueIndex);
+	void WorkerLoop(uint32_t threadIndex);
+
+	std::vector<std::thread> m_workers;
+	std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
+	//Submissions from threads outside the pool are spread over the queues
+	std::atomic<uint32_t> m_nextQueue;
+
+	std::mutex m_sleepMutex;
+	std::condition_variable m_taskAvailable;
+	std::atomic<uint32_t> m_queuedTaskCount;
+	bool m_isStopping;
+
+};
+
+template <typename Function>
+std::future<typename std::invoke_result<Function>::type> TaskScheduler::Submit(Function function) {
+
+	typedef typename std::invoke_result<Function>::type Result;
+
+	//std::function needs a copyable target, the packaged task is shared instead
+	std::shared_ptr<std::packaged_task<Result()>> task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+	std::future<Result> future = task->get_future();
+	QueuedTask queuedTask = { [task]() { (*task)(); }, nullptr };
+	Push(std::move(queuedTask));
+
+	return future;
+
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <polygon_chainer.h>
+#include <voronoi_cell_list.h>
+#include <voronoi_types.h>
+
+namespace VoronoiCore {
+
+//Voronoi cell clipped to the unit cube as an indexed convex polyhedron - face i is the loop of vertex indices
+//faceVertices [faceOffsets[i], faceOffsets[i + 1]), counter-clockwise seen from outside the cell
+//The face lies on the bisector plane of site faceNeighbors[i], or on the unit cube face of a negative neighbour (see VoronoiCellBuilder)
+struct VoronoiCell {
+
+	std::vector<Point> vertices;
+	std::vector<uint32_t> faceOffsets;
+	std::vector<uint32_t> faceVertices;
+	std::vector<int32_t> faceNeighbors;
+
+	uint32_t GetFaceCount() const { return faceOffsets.empty() ? 0 : static_cast<uint32_t>(faceOffsets.size() - 1); }
+
+	void Clear() {
+
+		vertices.clear();
+		faceOffsets.clear();
+		faceVertices.clear();
+		faceNeighbors.clear();
+
+	}
+
+};
+
+//Builds voronoi cells by clipping the unit cube with the bisector planes between a site and its delaunay neighbours
+//Cells do not depend on each other, a builder only holds the scratch of the cell it is clipping and appends the finished cell to a list
+class VoronoiCellBuilder {
+
+public:
+
+	//Unit cube faces z = 0, z = 1, y = 0, y = 1, x = 0, x = 1 as face neighbours -1 to -6
+	static const uint32_t UNIT_CUBE_FACE_COUNT = 6;
+
+	VoronoiCellBuilder();
+	~VoronoiCellBuilder();
+
+	//Append the cell of sites[site] against the sites listed in neighbors - empty when a neighbour coincides with the site
+	void Build(const Point* sites, uint32_t site, const uint32_t* neighbors, uint32_t neighborCount, VoronoiCellList* cells);
+
+	static bool IsUnitCubeFace(int32_t faceNeighbor);
+	static uint32_t GetUnitCubeFace(int32_t faceNeighbor);
+
+	//Outward normal of a unit cube face
+	static Point GetUnitCubeFaceNormal(uint32_t unitCubeFace);
+
+private:
+
+	//New vertex on the cell edge between two vertices
+	struct EdgeVertex {
+
+		uint64_t key;
+		uint32_t vertex;
+
+	};
+
+	//Keep the part of the cell where normal . x <= offset, the cut becomes a face of faceNeighbor
+	//Returns false once nothing is left of the cell
+	bool Clip(VoronoiCell* cell, const Point& normal, float offset, int32_t faceNeighbor);
+	uint32_t GetEdgeVertex(const VoronoiCell& cell, uint32_t keptVertex, uint32_t clippedVertex);
+
+	//Cell being clipped and the clipped cell, swapped after every plane
+	VoronoiCell m_cell;
+	VoronoiCell m_clippedCell;
+
+	std::vector<float> m_distances;
+	std::vector<uint32_t> m_vertexRemap;
+	std::vector<EdgeVertex> m_edgeVertices;
+
+	//Edges of the cut face, from the vertex where a face enters the kept part to the vertex where it leaves it
+	std::vector<EdgeIndex> m_cutEdges;
+	std::vector<uint32_t> m_cutFace;
+	PolygonChainer m_polygonChainer;
+
+};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <voronoi_types.h>
+
+namespace VoronoiCore {
+
+struct VoronoiCell;
+
+//Cell of a VoronoiCellList laid out like a VoronoiCell, valid until the list changes
+struct VoronoiCellView {
+
+	const Point* vertices;
+	const uint32_t* faceOffsets;
+	const uint32_t* faceVertices;
+	const int32_t* faceNeighbors;
+	uint32_t vertexCount;
+	uint32_t faceCount;
+
+	uint32_t GetFaceCount() const { return faceCount; }
+
+};
+
+//Cells of all sites in flat lists instead of four vectors per cell - the lists of cell i start at the offsets of cell i and end at the
+//offsets of cell i + 1. Indices inside a cell are relative to the cell, so cells and whole lists are appended as they are
+//Clear keeps the capacity, a list refilled every iteration stops allocating once it has held its largest cells
+class VoronoiCellList {
+
+public:
+
+	VoronoiCellList();
+	~VoronoiCellList();
+
+	void Clear();
+	void Swap(VoronoiCellList& cells);
+	uint32_t GetCellCount() const;
+	VoronoiCellView GetCell(uint32_t cell) const;
+
+	void Append(const VoronoiCell& cell);
+	void Append(const VoronoiCellView& cell);
+	void Append(const VoronoiCellList& cells);
+	void AppendEmpty();
+
+private:
+
+	//Start of a cell in every list
+	struct CellOffsets {
+
+		uint32_t vertices;
+		uint32_t faceOffsets;
+		uint32_t faceVertices;
+		uint32_t faceNeighbors;
+
+	};
+
+	void AppendOffsets();
+
+	//Cell count + 1 entries, the last one holds the list sizes
+	std::vector<CellOffsets> m_cellOffsets;
+
+	std::vector<Point> m_vertices;
+	std::vector<uint32_t> m_faceOffsets;
+	std::vector<uint32_t> m_faceVertices;
+	std::vector<int32_t> m_faceNeighbors;
+
+};
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <delaunay_triangulation.h>
+#include <polygon_chainer.h>
+#include <task_scheduler.h>
+#include <voronoi_cell_builder.h>
+#include <voronoi_types.h>
+
+namespace VoronoiCore {
+
+//Delaunay triangulation of 3D points and their voronoi diagram clipped to the unit cube
+class VoronoiDiagram {
+
+public:
+
+	//Cells are clipped and meshed in bands over the scheduler's threads, a null scheduler runs them on the calling thread
+	VoronoiDiagram(TaskScheduler* taskScheduler);
+	~VoronoiDiagram();
+	void Build(const Point* centroids, uint32_t centroidCount);
+
+	//Build again after some of the centroids moved - while few of them moved they are moved in the triangulation one by one instead of
+	//triangulating again, only the cells whose centroid, neighbours or list of neighbours changed are clipped again and only their
+	//meshes and the meshes that moved in the render lists are written again. Face colors are kept
+	//Builds everything when the centroid count changed or the previous triangulation left duplicates out
+	void Update(const Point* centroids, uint32_t centroidCount);
+
+	const std::vector<Tetrahedron>& GetTriangulation() const;
+	const std::vector<Tetrahedron>& GetCentroidTetrahedrons() const;
+	const std::vector<Edge>& GetDelaunayEdges() const;
+	const std::vector<VoronoiEdge>& GetVoronoiEdges() const;
+	const std::vector<ColorEdge>& GetVoronoiColoredEdges() const;
+	const std::vector<ColorTriangle>& GetVoronoiColoredTriangles() const;
+	const std::vector<Edge>& GetVoronoiFaces() const;
+	const std::vector<uint32_t>& GetVoronoiFacesCount() const;
+	const std::vector<ColorTriangle>& GetClippedVoronoiTriangles() const;
+	const std::vector<ColorTriangle>& GetClippedVoronoiCellsTriangles() const;
+	const std::vector<NormalColorTriangle>& GetClippedVoronoiTrianglesFaceNormals() const;
+	const std::vector<ColorEdge>& GetVoronoiEdgesUnitCube() const;
+	const std::vector<ColorTriangle>& GetClippedVoronoiCellsBackCulledTriangles() const;
+	const std::vector<NormalColorTriangle>& GetClippedVoronoiCellsBackCulledTrianglesNormals() const;
+	const std::vector<Edge>& GetUnitCubeEdges() const;
+
+	//Clipped cell of every centroid as an indexed polyhedron, empty for duplicates of a previous centroid
+	const VoronoiCellList& GetVoronoiCells() const;
+
+private:
+
+	//Sizes of the render lists of a cell, turned into the offsets of its triangles and edges in the lists by a prefix sum
+	//Shared faces are the faces towards a greater centroid, written once for both cells
+	struct CellMeshOffsets {
+
+		uint32_t cellTriangles;
+		uint32_t sharedTriangles;
+		uint32_t sharedEdges;
+		uint32_t unitCubeTriangles;
+		uint32_t unitCubeEdges;
+		uint32_t interiorTriangles;
+
+	};
+
+	void Clear();
+	void ConstructDelaunayEdges();
+	void ConstructVoronoiFaces();
+	void ConstructCells();
+	void ConstructCellTriangles();
+
+	uint32_t SplitCellBands(uint32_t* bandSize) const;
+	void RunCellBands(uint32_t bandCount, const std::function<void(uint32_t)>& band) const;
+	bool IsCellChanged(uint32_t centroidIndex) const;
+	bool IsCellMeshKept(uint32_t centroidIndex) const;
+	void MeasureCellMesh(uint32_t centroidIndex, const VoronoiCellView& cell);
+	void ConstructCellMesh(uint32_t centroidIndex);
+	uint32_t FindDelaunayEdge(uint32_t centroidA, uint32_t centroidB) const;
+	Point GetFaceColor(uint32_t centroidIndex, int32_t faceNeighbor) const;
+	Point GetFaceNormal(uint32_t centroidIndex, int32_t faceNeighbor) const;
+
+	static void CalculateCircumsphere(Tetrahedron* tetrahedron);
+
+	std::vector<Point> m_centroids;
+	std::vector<uint8_t> m_isCentroidMoved;
+
+	//Delaunay - edges are sorted by their first then second centroid, the edges of centroid i with a greater centroid start at
+	//m_delaunayEdgeOffsets[i]
+	std::unique_ptr<DelaunayTriangulation> m_delaunayTriangulation;
+	std::vector<Tetrahedron> m_triangulation;
+	std::vector<Point> m_circumcenters;
+	std::vector<uint64_t> m_delaunayEdgeKeys;
+	std::vector<Edge> m_delaunayEdges;
+	std::vector<EdgeIndex> m_delaunayEdgesIndex;
+	std::vector<uint32_t> m_delaunayEdgeOffsets;
+	std::vector<Point> m_delaunayEdgeColors;
+	std::vector<uint64_t> m_previousDelaunayEdgeKeys;
+	std::vector<Point> m_previousDelaunayEdgeColors;
+	std::vector<Tetrahedron> m_centroidTetrahedrons;
+
+	//Voronoi - edges join the circumcenters of two tetrahedron slots, the pairs of delaunay edge and voronoi edge are sorted so the
+	//voronoi face of delaunay edge i is bounded by the pairs [m_voronoiFaceOffsets[i], m_voronoiFaceOffsets[i + 1])
+	std::vector<VoronoiEdge> m_voronoiEdges;
+	std::vector<EdgeIndex> m_voronoiEdgesIndex;
+	std::vector<EdgeIndex> m_voronoiFaceEdgePairs;
+	std::vector<uint32_t> m_voronoiFaceOffsets;
+	std::vector<EdgeIndex> m_voronoiFace;
+	std::vector<uint32_t> m_voronoiFaceLoop;
+	std::unique_ptr<PolygonChainer> m_polygonChainer;
+	std::vector<ColorEdge> m_voronoiColoredEdges;
+	std::vector<ColorTriangle> m_voronoiColoredTriangles;
+	std::vector<Edge> m_voronoiFaces;
+	std::vector<uint32_t> m_voronoiFacesCount;
+
+	//Cells - the delaunay neighbours of centroid i are [m_centroidNeighborOffsets[i], m_centroidNeighborOffsets[i + 1]) of
+	//m_centroidNeighbors, the faces on the unit cube get a color per cell
+	//Every band of cells has its own builder and cell list, the band lists are appended into the cells in band order and the bands
+	//write their meshes at the prefix summed offsets of their cells
+	//An update compares the neighbours and offsets with the previous ones, the unchanged cells are copied from the previous cells and
+	//keep their meshes. Every list here is cleared, never freed, so iterations of the same size stop allocating
+	TaskScheduler* m_taskScheduler;
+	std::vector<std::unique_ptr<VoronoiCellBuilder>> m_cellBuilders;
+	std::vector<uint32_t> m_centroidNeighborOffsets;
+	std::vector<uint32_t> m_centroidNeighbors;
+	std::vector<uint32_t> m_centroidNeighborCursors;
+	std::vector<uint32_t> m_previousCentroidNeighborOffsets;
+	std::vector<uint32_t> m_previousCentroidNeighbors;
+	std::vector<uint8_t> m_isCellChanged;
+	std::vector<VoronoiCellList> m_bandCells;
+	VoronoiCellList m_voronoiCells;
+	VoronoiCellList m_previousVoronoiCells;
+	std::vector<Point> m_unitCubeFaceColors;
+	std::vector<CellMeshOffsets> m_cellMeshOffsets;
+	std::vector<CellMeshOffsets> m_previousCellMeshOffsets;
+
+	//Output
+	std::vector<ColorTriangle> m_clippedVoronoiTriangles;
+	std::vector<ColorTriangle> m_clippedVoronoiCellsTriangles;
+	std::vector<NormalColorTriangle> m_clippedVoronoiTrianglesFaceNormals;
+	std::vector<ColorEdge> m_voronoiEdgesUnitCube;
+	std::vector<ColorTriangle> m_clippedVoronoiCellsBackCulledTriangles;
+	std::vector<NormalColorTriangle> m_clippedVoronoiCellsBackCulledTrianglesNormals;
+	std::vector<Edge> m_unitCubeEdges;
+
+};
+
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace VoronoiCore {
+
+struct Point {
+
+public:
+
+	float x;
+	float y;
+	float z;
+
+	Point(float x, float y, float z) : x(x), y(y), z(z) {}
+	Point() : x(0.0f), y(0.0f), z(0.0f) {}
+
+	Point& operator*=(const float& scalar) {
+
+		this->x *= scalar;
+		this->y *= scalar;
+		this->z *= scalar;
+
+		return *this;
+
+	}
+
+	Point& operator-=(const float& scalar) {
+
+		this->x -= scalar;
+		this->y -= scalar;
+		this->z -= scalar;
+
+		return *this;
+
+	}
+	Point& operator-=(const Point& point) {
+
+		this->x -= point.x;
+		this->y -= point.y;
+		this->z -= point.z;
+
+		return *this;
+
+	}
+
+	Point& operator+=(const float& scalar) {
+
+		this->x += scalar;
+		this->y += scalar;
+		this->z += scalar;
+
+		return *this;
+
+	}
+	Point& operator+=(const Point& point) {
+
+		this->x += point.x;
+		this->y += point.y;
+		this->z += point.z;
+
+		return *this;
+
+	}
+
+};
+
+struct Edge {
+
+	Point a;
+	Point b;
+
+	Edge(Point a, Point b) : a(a), b(b) {}
+	Edge() : a(Point()), b(Point()) {}
+
+};
+
+struct Triangle {
+
+public:
+
+	Point a;
+	Point b;
+	Point c;
+
+	Triangle(Point a, Point b, Point c) : a(a), b(b), c(c) {}
+	Triangle() : a(Point()), b(Point()), c(Point()) {}
+
+};
+
+struct VoronoiEdge : Edge {
+
+	VoronoiEdge(Point a, Point b) : Edge(a, b) {}
+
+};
+
+struct ColorEdge : Edge {
+
+	Point color;
+
+	ColorEdge(Point a, Point b, Point color) : Edge(a, b), color(color) {}
+	ColorEdge() : Edge(), color(Point()) {}
+
+};
+
+struct ColorTriangle : Triangle {
+
+	Point color;
+
+	ColorTriangle(Point a, Point b, Point c, Point color) : Triangle(a, b, c), color(color) {}
+	ColorTriangle() : Triangle(), color(Point()) {}
+
+};
+
+struct NormalColorTriangle : ColorTriangle {
+
+	Point normal;
+
+	NormalColorTriangle(Point a, Point b, Point c, Point color, Point normal) : ColorTriangle(a, b, c, color), normal(normal) {}
+	NormalColorTriangle() : ColorTriangle(), normal(Point()) {}
+
+};
+
+struct Tetrahedron {
+
+	Point a;
+	Point b;
+	Point c;
+	Point d;
+	Point circumcenter;
+	float circumradius;
+
+};
+
+struct EdgeIndex {
+
+	uint32_t a;
+	uint32_t b;
+
+	EdgeIndex() : a(0), b(0) {}
+	EdgeIndex(uint32_t a, uint32_t b) : a(a), b(b) {}
+
+};
+
+struct Plane {
+
+	float xCoef;
+	float yCoef;
+	float zCoef;
+	float kCoef;
+
+	Plane(float xCoef, float yCoef, float zCoef, float kCoef) : xCoef(xCoef), yCoef(yCoef), zCoef(zCoef), kCoef(kCoef) {}
+	Plane() : xCoef(0.0f), yCoef(0.0f), zCoef(0.0f), kCoef(0.0f) {}
+
+};
+
+typedef Plane PlaneNORMAL;
+
+//Vector helpers - points are used as 3D vectors
+
+inline Point Subtract(const Point& a, const Point& b) {
+
+	return Point(a.x - b.x, a.y - b.y, a.z - b.z);
+
+}
+
+inline float Dot(const Point& a, const Point& b) {
+
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+
+}
+
+inline Point Cross(const Point& a, const Point& b) {
+
+	return Point(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+
+}
+
+//Returns the zero vector for zero length input
+inline Point Normalize(const Point& a) {
+
+	float length = std::sqrt(Dot(a, a));
+	if (length == 0.0f) return Point();
+	return Point(a.x / length, a.y / length, a.z / length);
+
+}
+
+}
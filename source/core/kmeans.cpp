@@ -0,0 +1,929 @@
+#include <kmeans.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace VoronoiCore {
+
+namespace {
+
+//Pixels assigned per kernel call - keeps the assignment buffer on the stack and in L1
+const size_t ASSIGN_BLOCK_SIZE = 4096;
+
+//Bands per scheduler thread - a few more bands than threads evens out cores finishing at different times
+const size_t BANDS_PER_THREAD = 4;
+
+//Random seed until SetRandomSeed - runs are reproducible by default
+const uint64_t DEFAULT_RANDOM_SEED = 0x5EEDC0102ull;
+
+//Mini-batches of 4096 random pixels, learning rates of the per-centroid counts without a floor
+const MiniBatchSettings DEFAULT_MINI_BATCH_SETTINGS = { 4096, MINI_BATCH_SAMPLING_RANDOM, 0.0f };
+
+}
+
+KMeans::KMeans(uint32_t centroidCount, TaskScheduler* taskScheduler) :
+	m_centroids(centroidCount),
+	m_simdLevel(DetectSimdLevel()),
+	m_centroidTableR(centroidCount),
+	m_centroidTableG(centroidCount),
+	m_centroidTableB(centroidCount),
+	m_centroidPixels(centroidCount),
+	m_isFixedPointAssignment(false),
+	m_fixedCentroidTableRB(centroidCount),
+	m_fixedCentroidTableG(centroidCount),
+	m_taskScheduler(taskScheduler),
+	m_algorithm(KMEANS_ALGORITHM_BRUTE_FORCE),
+	m_previousCentroidTableR(centroidCount),
+	m_previousCentroidTableG(centroidCount),
+	m_previousCentroidTableB(centroidCount),
+	m_arePreviousAssignmentsValid(false),
+	m_iterationStatistics({ -1.0f, -1.0f, -1.0, 0 }),
+	m_miniBatchSettings(DEFAULT_MINI_BATCH_SETTINGS),
+	m_miniBatchCounts(centroidCount, 0) {
+
+	m_seeder = std::make_unique<KMeansSeeder>(DEFAULT_RANDOM_SEED, taskScheduler);
+	m_colorSpaceConverter = std::make_unique<ColorSpaceConverter>(COLOR_SPACE_RGB);
+	m_miniBatchSampler = std::make_unique<MiniBatchSampler>(DEFAULT_RANDOM_SEED);
+	m_assignKernel = GetAssignKernel(m_simdLevel);
+	m_assignFixedKernel = GetAssignFixedKernel(m_simdLevel);
+	m_kdTree = std::make_unique<CentroidKdTree>();
+	m_paletteLut = std::make_unique<PaletteLut>();
+	UpdateCentroidTable();
+
+	m_bounds = std::make_unique<KMeansBounds>(centroidCount, m_simdLevel);
+
+}
+
+KMeans::~KMeans() {}
+
+//Random centroids in the unit RGB cube
+void KMeans::ResetCentroids() {
+
+	m_seeder->SeedUniform(GetCentroidCount(), m_centroids.data());
+
+	UpdateCentroidTable();
+	m_bounds->Invalidate();
+	InvalidateAssignments();
+
+}
+
+void KMeans::SeedCentroids(const uint32_t* pixels, size_t pixelCount, SeedingMethod method) {
+
+	m_seeder->Seed(method, pixels, nullptr, pixelCount, GetCentroidCount(), m_centroids.data());
+
+	UpdateCentroidTable();
+	m_bounds->Invalidate();
+	InvalidateAssignments();
+
+}
+
+//Every histogram entry weighs as much as its pixels
+void KMeans::SeedCentroids(const ColorHistogram& histogram, SeedingMethod method) {
+
+	m_seeder->Seed(method, histogram.GetEntryColors(), histogram.GetEntryCounts(), histogram.GetEntryCount(), GetCentroidCount(), m_centroids.data());
+
+	UpdateCentroidTable();
+	m_bounds->Invalidate();
+	InvalidateAssignments();
+
+}
+
+void KMeans::SetRandomSeed(uint64_t seed) {
+
+	m_seeder->SetSeed(seed);
+	m_miniBatchSampler->SetSeed(seed);
+
+}
+
+//Replace every pixel with the color of its closest centroid
+void KMeans::QuantizeFrame(const uint32_t* pixels, size_t pixelCount, uint32_t* quantizedPixels) const {
+
+	AssignFrame(pixels, pixelCount, quantizedPixels, nullptr, nullptr, nullptr, nullptr);
+
+}
+
+//One k-means iteration - move every centroid to the mean of its pixels, empty clusters take one half of the largest ones
+void KMeans::UpdateCentroids(const uint32_t* pixels, size_t pixelCount) {
+
+	AssignAndMoveCentroids(pixels, pixelCount, nullptr, nullptr);
+
+}
+
+//QuantizeFrame and UpdateCentroids in a single sweep - every pixel is read and assigned once per iteration
+void KMeans::QuantizeFrameAndUpdateCentroids(const uint32_t* pixels, size_t pixelCount, uint32_t* quantizedPixels) {
+
+	AssignAndMoveCentroids(pixels, pixelCount, quantizedPixels, nullptr);
+
+}
+
+//UpdateCentroids over the histogram entries, every entry weighs as much as its pixels
+void KMeans::UpdateCentroids(const ColorHistogram& histogram) {
+
+	AssignAndMoveCentroids(histogram.GetEntryColors(), histogram.GetEntryCount(), nullptr, &histogram);
+
+}
+
+//QuantizeFrameAndUpdateCentroids over the histogram entries - the frame is written from the quantized entry colors
+void KMeans::QuantizeFrameAndUpdateCentroids(const ColorHistogram& histogram, uint32_t* quantizedPixels) {
+
+	m_entryQuantizedPixels.resize(histogram.GetEntryCount());
+	AssignAndMoveCentroids(histogram.GetEntryColors(), histogram.GetEntryCount(), m_entryQuantizedPixels.data(), &histogram);
+
+	const uint32_t* pixelEntries = histogram.GetPixelEntries();
+	const uint32_t* entryQuantizedPixels = m_entryQuantizedPixels.data();
+	size_t pixelCount = histogram.GetPixelCount();
+
+	size_t bandSize = 0;
+	size_t bandCount = SplitBands(pixelCount, &bandSize);
+
+	RunBands(bandCount, [&](uint32_t bandIndex) {
+
+		size_t bandStart = static_cast<size_t>(bandIndex) * bandSize;
+		size_t bandEnd = bandStart + bandSize < pixelCount ? bandStart + bandSize : pixelCount;
+
+		for (size_t i = bandStart; i < bandEnd; ++i) quantizedPixels[i] = entryQuantizedPixels[pixelEntries[i]];
+
+	});
+
+}
+
+//Sculley's mini-batch k-means - the batches are assigned like a frame, every centroid then moves towards the mean of its batch pixels
+void KMeans::UpdateCentroidsMiniBatch(const uint32_t* pixels, size_t pixelCount, uint32_t batchCount) {
+
+	if (pixelCount == 0 || batchCount == 0) return;
+
+	m_previousCentroidTableR = m_centroidTableR;
+	m_previousCentroidTableG = m_centroidTableG;
+	m_previousCentroidTableB = m_centroidTableB;
+
+	m_miniBatchPixels.resize(m_miniBatchSettings.batchSize);
+
+	for (uint32_t i = 0; i < batchCount; ++i) {
+
+		m_miniBatchSampler->Sample(m_miniBatchSettings.sampling, pixels, pixelCount, m_miniBatchPixels.size(), m_miniBatchPixels.data());
+		AssignFrame(m_miniBatchPixels.data(), m_miniBatchPixels.size(), nullptr, &m_bandCentroidSums, nullptr, nullptr, nullptr);
+		MoveCentroidsTowardsBatchMeans();
+
+	}
+
+	//The bounds only follow the moves of full iterations
+	m_bounds->Invalidate();
+
+	float maxShift = 0.0f;
+	for (size_t i = 0; i < m_centroids.size(); ++i) {
+
+		float distanceR = m_centroidTableR[i] - m_previousCentroidTableR[i];
+		float distanceG = m_centroidTableG[i] - m_previousCentroidTableG[i];
+		float distanceB = m_centroidTableB[i] - m_previousCentroidTableB[i];
+		float shift = std::sqrt(distanceR * distanceR + distanceG * distanceG + distanceB * distanceB) / 255.0f;
+		if (shift > maxShift) maxShift = shift;
+
+	}
+
+	m_iterationStatistics.maxCentroidShift = maxShift;
+	m_iterationStatistics.reassignedRatio = -1.0f;
+	m_iterationStatistics.inertia = -1.0;
+	m_iterationStatistics.repairedClusterCount = 0;
+
+}
+
+void KMeans::SetMiniBatchSettings(const MiniBatchSettings& settings) {
+
+	m_miniBatchSettings = settings;
+	if (m_miniBatchSettings.batchSize == 0) m_miniBatchSettings.batchSize = 1;
+
+}
+
+const MiniBatchSettings& KMeans::GetMiniBatchSettings() const {
+
+	return m_miniBatchSettings;
+
+}
+
+uint32_t KMeans::GetCentroidCount() const {
+
+	return static_cast<uint32_t>(m_centroids.size());
+
+}
+
+const Point* KMeans::GetCentroids() const {
+
+	return m_centroids.data();
+
+}
+
+void KMeans::SetCentroids(const Point* centroids) {
+
+	for (size_t i = 0; i < m_centroids.size(); ++i) m_centroids[i] = centroids[i];
+
+	UpdateCentroidTable();
+	m_bounds->Invalidate();
+	InvalidateAssignments();
+
+}
+
+SimdLevel KMeans::GetSimdLevel() const {
+
+	return m_simdLevel;
+
+}
+
+uint32_t KMeans::SplitCentroids(const ColorHistogram& histogram, uint32_t splitCount) {
+
+	MeasureClusters(histogram.GetEntryColors(), histogram.GetEntryCount(), &histogram);
+
+	std::vector<uint32_t> largestClusters = FindLargestClusters(splitCount);
+	if (largestClusters.empty()) return 0;
+
+	uint32_t centroidCount = GetCentroidCount();
+	ResizeCentroids(centroidCount + static_cast<uint32_t>(largestClusters.size()));
+
+	for (size_t i = 0; i < largestClusters.size(); ++i) SplitCluster(largestClusters[i], centroidCount + static_cast<uint32_t>(i));
+
+	UpdateCentroidTable();
+
+	return static_cast<uint32_t>(largestClusters.size());
+
+}
+
+//Merges leave the pixels where they are, so the moments of a merged cluster are the sums of both and the costs of the next merges stay exact
+uint32_t KMeans::MergeCentroids(const ColorHistogram& histogram, double maxInertiaIncrease, uint32_t minCentroidCount) {
+
+	if (GetCentroidCount() <= minCentroidCount || GetCentroidCount() < 2) return 0;
+
+	MeasureClusters(histogram.GetEntryColors(), histogram.GetEntryCount(), &histogram);
+
+	uint32_t centroidCount = GetCentroidCount();
+	double inertiaIncrease = 0.0;
+
+	while (centroidCount > minCentroidCount && centroidCount > 1) {
+
+		//Merging clusters i and j adds count_i * count_j / (count_i + count_j) times their squared mean distance to the inertia
+		uint32_t mergeIndexA = 0;
+		uint32_t mergeIndexB = 0;
+		double minIncrease = -1.0;
+		for (uint32_t i = 0; i < centroidCount; ++i) {
+
+			double countI = m_clusterMoments.count[i];
+
+			for (uint32_t j = i + 1; j < centroidCount; ++j) {
+
+				double countJ = m_clusterMoments.count[j];
+				double increase = 0.0;
+
+				if (countI != 0.0 && countJ != 0.0) {
+
+					double distanceR = m_clusterMoments.r[i] / countI - m_clusterMoments.r[j] / countJ;
+					double distanceG = m_clusterMoments.g[i] / countI - m_clusterMoments.g[j] / countJ;
+					double distanceB = m_clusterMoments.b[i] / countI - m_clusterMoments.b[j] / countJ;
+					increase = countI * countJ / (countI + countJ) * (distanceR * distanceR + distanceG * distanceG + distanceB * distanceB);
+
+				}
+
+				if (minIncrease < 0.0 || increase < minIncrease) {
+
+					minIncrease = increase;
+					mergeIndexA = i;
+					mergeIndexB = j;
+
+				}
+
+			}
+
+		}
+
+		if (inertiaIncrease + minIncrease > maxInertiaIncrease) break;
+		inertiaIncrease += minIncrease;
+
+		//The merged cluster sits at the mean of both, an empty one leaves the other in place - the last cluster moves into the freed slot
+		double count = m_clusterMoments.count[mergeIndexA] + m_clusterMoments.count[mergeIndexB];
+		if (m_clusterMoments.count[mergeIndexA] == 0.0) {
+
+			m_centroids[mergeIndexA] = m_centroids[mergeIndexB];
+
+		}
+		else if (m_clusterMoments.count[mergeIndexB] != 0.0) {
+
+			double scale = 1.0 / (255.0 * count);
+			m_centroids[mergeIndexA].x = static_cast<float>((m_clusterMoments.r[mergeIndexA] + m_clusterMoments.r[mergeIndexB]) * scale);
+			m_centroids[mergeIndexA].y = static_cast<float>((m_clusterMoments.g[mergeIndexA] + m_clusterMoments.g[mergeIndexB]) * scale);
+			m_centroids[mergeIndexA].z = static_cast<float>((m_clusterMoments.b[mergeIndexA] + m_clusterMoments.b[mergeIndexB]) * scale);
+
+		}
+
+		m_clusterMoments.count[mergeIndexA] = count;
+		m_clusterMoments.r[mergeIndexA] += m_clusterMoments.r[mergeIndexB];
+		m_clusterMoments.g[mergeIndexA] += m_clusterMoments.g[mergeIndexB];
+		m_clusterMoments.b[mergeIndexA] += m_clusterMoments.b[mergeIndexB];
+
+		centroidCount--;
+		m_centroids[mergeIndexB] = m_centroids[centroidCount];
+		m_clusterMoments.count[mergeIndexB] = m_clusterMoments.count[centroidCount];
+		m_clusterMoments.r[mergeIndexB] = m_clusterMoments.r[centroidCount];
+		m_clusterMoments.g[mergeIndexB] = m_clusterMoments.g[centroidCount];
+		m_clusterMoments.b[mergeIndexB] = m_clusterMoments.b[centroidCount];
+
+	}
+
+	uint32_t mergeCount = GetCentroidCount() - centroidCount;
+	if (mergeCount == 0) return 0;
+
+	ResizeCentroids(centroidCount);
+	UpdateCentroidTable();
+
+	return mergeCount;
+
+}
+
+void KMeans::SetAlgorithm(KMeansAlgorithm algorithm) {
+
+	m_algorithm = algorithm;
+	m_bounds->Invalidate();
+
+	if (m_algorithm == KMEANS_ALGORITHM_KD_TREE) {
+
+		CentroidTable centroidTable = { m_centroidTableR.data(), m_centroidTableG.data(), m_centroidTableB.data(), GetCentroidCount() };
+		m_kdTree->Build(centroidTable);
+
+	}
+
+}
+
+KMeansAlgorithm KMeans::GetAlgorithm() const {
+
+	return m_algorithm;
+
+}
+
+//The centroids keep their coordinates, only their quantized colors change
+void KMeans::SetColorSpace(ColorSpace colorSpace) {
+
+	m_colorSpaceConverter = std::make_unique<ColorSpaceConverter>(colorSpace);
+	UpdateCentroidTable();
+
+}
+
+ColorSpace KMeans::GetColorSpace() const {
+
+	return m_colorSpaceConverter->GetColorSpace();
+
+}
+
+void KMeans::SetFixedPointAssignment(bool isFixedPoint) {
+
+	m_isFixedPointAssignment = isFixedPoint;
+
+}
+
+bool KMeans::IsFixedPointAssignment() const {
+
+	return m_isFixedPointAssignment;
+
+}
+
+void KMeans::InvalidateBounds() {
+
+	m_bounds->Invalidate();
+	InvalidateAssignments();
+
+}
+
+const IterationStatistics& KMeans::GetIterationStatistics() const {
+
+	return m_iterationStatistics;
+
+}
+
+void KMeans::BuildPaletteLut(uint32_t gridBits) {
+
+	CentroidTable centroidTable = { m_centroidTableR.data(), m_centroidTableG.data(), m_centroidTableB.data(), GetCentroidCount() };
+	m_paletteLut->Build(centroidTable, gridBits);
+
+}
+
+bool KMeans::IsPaletteLutBuilt() const {
+
+	return m_paletteLut->IsBuilt();
+
+}
+
+//Split itemCount items into bands of whole assignment blocks so only the last block is partial
+size_t KMeans::SplitBands(size_t itemCount, size_t* bandSize) const {
+
+	size_t blockCount = (itemCount + ASSIGN_BLOCK_SIZE - 1) / ASSIGN_BLOCK_SIZE;
+	size_t bandCount = m_taskScheduler != nullptr ? static_cast<size_t>(m_taskScheduler->GetThreadCount()) * BANDS_PER_THREAD : 1;
+	if (bandCount > blockCount) bandCount = blockCount;
+	if (bandCount == 0) {
+
+		*bandSize = 0;
+		return 0;
+
+	}
+
+	size_t bandBlockCount = (blockCount + bandCount - 1) / bandCount;
+	*bandSize = bandBlockCount * ASSIGN_BLOCK_SIZE;
+
+	return (blockCount + bandBlockCount - 1) / bandBlockCount;
+
+}
+
+void KMeans::RunBands(size_t bandCount, const std::function<void(uint32_t)>& band) const {
+
+	if (m_taskScheduler != nullptr) {
+
+		m_taskScheduler->ParallelFor(static_cast<uint32_t>(bandCount), band);
+
+	}
+	else {
+
+		for (uint32_t i = 0; i < bandCount; ++i) band(i);
+
+	}
+
+}
+
+//Assign the frame in bands - writes the quantized pixels and/or the per-band sums when not null
+//With bounds the assignments come from the bounded search, with a built palette table from its lookups, else from the k-d tree
+//or the SIMD kernel, float or fixed point
+//With a histogram the pixels are its entry colors and every entry adds its pixel sums
+//With previous assignments the bands count the pixels whose centroid changed and store the new assignments
+void KMeans::AssignFrame(const uint32_t* pixels, size_t pixelCount, uint32_t* quantizedPixels, std::vector<CentroidSums>* bandSums, KMeansBounds* bounds,
+	const ColorHistogram* histogram, uint32_t* previousAssignments) const {
+
+	CentroidTable centroidTable = { m_centroidTableR.data(), m_centroidTableG.data(), m_centroidTableB.data(), GetCentroidCount() };
+	FixedCentroidTable fixedCentroidTable = { m_fixedCentroidTableRB.data(), m_fixedCentroidTableG.data(), GetCentroidCount() };
+
+	size_t bandSize = 0;
+	size_t bandCount = SplitBands(pixelCount, &bandSize);
+
+	if (bandSums != nullptr) {
+
+		if (bandSums->size() < bandCount) bandSums->resize(bandCount);
+		for (size_t i = 0; i < bandSums->size(); ++i) {
+
+			CentroidSums& sums = (*bandSums)[i];
+			sums.r.assign(m_centroids.size(), 0);
+			sums.g.assign(m_centroids.size(), 0);
+			sums.b.assign(m_centroids.size(), 0);
+			sums.count.assign(m_centroids.size(), 0);
+			sums.squaredNorm = 0;
+			sums.reassignedCount = 0;
+
+		}
+
+	}
+
+	RunBands(bandCount, [&](uint32_t bandIndex) {
+
+		size_t bandStart = static_cast<size_t>(bandIndex) * bandSize;
+		size_t bandEnd = bandStart + bandSize < pixelCount ? bandStart + bandSize : pixelCount;
+
+		uint32_t assignments[ASSIGN_BLOCK_SIZE];
+
+		for (size_t blockStart = bandStart; blockStart < bandEnd; blockStart += ASSIGN_BLOCK_SIZE) {
+
+			size_t blockSize = bandEnd - blockStart < ASSIGN_BLOCK_SIZE ? bandEnd - blockStart : ASSIGN_BLOCK_SIZE;
+			const uint32_t* blockPixels = pixels + blockStart;
+			const uint32_t* blockAssignments = assignments;
+			if (bounds != nullptr) {
+
+				blockAssignments = bounds->AssignBlock(blockStart, blockSize, centroidTable);
+
+			}
+			else if (m_paletteLut->IsBuilt()) {
+
+				m_paletteLut->Assign(blockPixels, blockSize, assignments);
+
+			}
+			else if (m_algorithm == KMEANS_ALGORITHM_KD_TREE) {
+
+				m_kdTree->Assign(blockPixels, blockSize, assignments);
+
+			}
+			else if (m_isFixedPointAssignment) {
+
+				m_assignFixedKernel(blockPixels, blockSize, fixedCentroidTable, assignments);
+
+			}
+			else {
+
+				m_assignKernel(blockPixels, blockSize, centroidTable, assignments);
+
+			}
+
+			//The output may be write-combined upload memory, so it is only ever written
+			if (quantizedPixels != nullptr) {
+
+				for (size_t i = 0; i < blockSize; ++i) quantizedPixels[blockStart + i] = m_centroidPixels[blockAssignments[i]];
+
+			}
+
+			if (bandSums != nullptr) {
+
+				uint64_t* sumsR = (*bandSums)[bandIndex].r.data();
+				uint64_t* sumsG = (*bandSums)[bandIndex].g.data();
+				uint64_t* sumsB = (*bandSums)[bandIndex].b.data();
+				uint32_t* sumsCount = (*bandSums)[bandIndex].count.data();
+
+				if (histogram != nullptr) {
+
+					const uint64_t* entrySumsR = histogram->GetEntrySumsR() + blockStart;
+					const uint64_t* entrySumsG = histogram->GetEntrySumsG() + blockStart;
+					const uint64_t* entrySumsB = histogram->GetEntrySumsB() + blockStart;
+					const uint32_t* entryCounts = histogram->GetEntryCounts() + blockStart;
+
+					for (size_t i = 0; i < blockSize; ++i) {
+
+						uint32_t centroidIndex = blockAssignments[i];
+
+						sumsR[centroidIndex] += entrySumsR[i];
+						sumsG[centroidIndex] += entrySumsG[i];
+						sumsB[centroidIndex] += entrySumsB[i];
+						sumsCount[centroidIndex] += entryCounts[i];
+
+					}
+
+				}
+				else {
+
+					uint64_t squaredNorm = 0;
+
+					for (size_t i = 0; i < blockSize; ++i) {
+
+						uint32_t centroidIndex = blockAssignments[i];
+						uint32_t colorR = (blockPixels[i] >> 16) & 0xFF;
+						uint32_t colorG = (blockPixels[i] >> 8) & 0xFF;
+						uint32_t colorB = blockPixels[i] & 0xFF;
+
+						sumsR[centroidIndex] += colorR;
+						sumsG[centroidIndex] += colorG;
+						sumsB[centroidIndex] += colorB;
+						sumsCount[centroidIndex] += 1;
+						squaredNorm += colorR * colorR + colorG * colorG + colorB * colorB;
+
+					}
+
+					(*bandSums)[bandIndex].squaredNorm += squaredNorm;
+
+				}
+
+				if (previousAssignments != nullptr) {
+
+					const uint32_t* entryCounts = histogram != nullptr ? histogram->GetEntryCounts() + blockStart : nullptr;
+					uint32_t* blockPreviousAssignments = previousAssignments + blockStart;
+					uint64_t reassignedCount = 0;
+
+					for (size_t i = 0; i < blockSize; ++i) {
+
+						if (blockPreviousAssignments[i] != blockAssignments[i]) {
+
+							reassignedCount += entryCounts != nullptr ? entryCounts[i] : 1;
+							blockPreviousAssignments[i] = blockAssignments[i];
+
+						}
+
+					}
+
+					(*bandSums)[bandIndex].reassignedCount += reassignedCount;
+
+				}
+
+			}
+
+		}
+
+	});
+
+}
+
+//One k-means iteration, optionally writing the quantized pixels on the way
+void KMeans::AssignAndMoveCentroids(const uint32_t* pixels, size_t pixelCount, uint32_t* quantizedPixels, const ColorHistogram* histogram) {
+
+	//A frame of another size cannot be the one the previous assignments belong to, invalid ones never match a centroid
+	if (!m_arePreviousAssignmentsValid || m_previousAssignments.size() != pixelCount) m_previousAssignments.assign(pixelCount, 0xFFFFFFFF);
+	m_arePreviousAssignmentsValid = true;
+
+	m_previousCentroidTableR = m_centroidTableR;
+	m_previousCentroidTableG = m_centroidTableG;
+	m_previousCentroidTableB = m_centroidTableB;
+
+	if (m_algorithm == KMEANS_ALGORITHM_BRUTE_FORCE || m_algorithm == KMEANS_ALGORITHM_KD_TREE) {
+
+		AssignFrame(pixels, pixelCount, quantizedPixels, &m_bandCentroidSums, nullptr, histogram, m_previousAssignments.data());
+		MoveCentroidsToMeans(pixels, pixelCount, histogram);
+		return;
+
+	}
+
+	CentroidTable centroidTable = { m_centroidTableR.data(), m_centroidTableG.data(), m_centroidTableB.data(), GetCentroidCount() };
+	m_bounds->BeginPass(pixels, pixelCount, centroidTable, m_algorithm);
+
+	AssignFrame(pixels, pixelCount, quantizedPixels, &m_bandCentroidSums, m_bounds.get(), histogram, m_previousAssignments.data());
+	MoveCentroidsToMeans(pixels, pixelCount, histogram);
+
+	CentroidTable previousCentroidTable = { m_previousCentroidTableR.data(), m_previousCentroidTableG.data(), m_previousCentroidTableB.data(), GetCentroidCount() };
+	m_bounds->EndPass(previousCentroidTable, centroidTable);
+
+}
+
+//Reduce the per-band sums and move every centroid to the mean of its pixels, empty clusters are repaired from the largest ones
+//The iteration statistics come from the same sums - inertia is the sum of squares minus the squared sums over the cluster sizes
+void KMeans::MoveCentroidsToMeans(const uint32_t* pixels, size_t pixelCount, const ColorHistogram* histogram) {
+
+	uint64_t squaredNorm = 0;
+	uint64_t reassignedCount = 0;
+	uint64_t totalCount = 0;
+	double betweenClusters = 0.0;
+	uint32_t emptyClusterCount = 0;
+
+	for (size_t j = 0; j < m_bandCentroidSums.size(); ++j) {
+
+		squaredNorm += m_bandCentroidSums[j].squaredNorm;
+		reassignedCount += m_bandCentroidSums[j].reassignedCount;
+
+	}
+
+	for (size_t i = 0; i < m_centroids.size(); ++i) {
+
+		uint64_t sumR = 0;
+		uint64_t sumG = 0;
+		uint64_t sumB = 0;
+		uint64_t sumCount = 0;
+
+		for (size_t j = 0; j < m_bandCentroidSums.size(); ++j) {
+
+			sumR += m_bandCentroidSums[j].r[i];
+			sumG += m_bandCentroidSums[j].g[i];
+			sumB += m_bandCentroidSums[j].b[i];
+			sumCount += m_bandCentroidSums[j].count[i];
+
+		}
+
+		if (sumCount != 0) {
+
+			float scale = 1.0f / (255.0f * static_cast<float>(sumCount));
+
+			m_centroids[i].x = static_cast<float>(sumR) * scale;
+			m_centroids[i].y = static_cast<float>(sumG) * scale;
+			m_centroids[i].z = static_cast<float>(sumB) * scale;
+
+			double squaredSum = static_cast<double>(sumR) * static_cast<double>(sumR) + static_cast<double>(sumG) * static_cast<double>(sumG) +
+				static_cast<double>(sumB) * static_cast<double>(sumB);
+			betweenClusters += squaredSum / static_cast<double>(sumCount);
+			totalCount += sumCount;
+
+		}
+		else {
+
+			emptyClusterCount++;
+
+		}
+
+	}
+
+	UpdateCentroidTable();
+
+	//Empty centroids waste their distance computations, they are moved into the clusters with the largest errors
+	uint32_t repairedClusterCount = emptyClusterCount != 0 ? RepairEmptyClusters(pixels, pixelCount, histogram) : 0;
+
+	float maxShift = 0.0f;
+	for (size_t i = 0; i < m_centroids.size(); ++i) {
+
+		float distanceR = m_centroidTableR[i] - m_previousCentroidTableR[i];
+		float distanceG = m_centroidTableG[i] - m_previousCentroidTableG[i];
+		float distanceB = m_centroidTableB[i] - m_previousCentroidTableB[i];
+		float shift = std::sqrt(distanceR * distanceR + distanceG * distanceG + distanceB * distanceB) / 255.0f;
+		if (shift > maxShift) maxShift = shift;
+
+	}
+
+	if (histogram != nullptr) squaredNorm = histogram->GetSquaredNormSum();
+	double inertia = static_cast<double>(squaredNorm) - betweenClusters;
+
+	m_iterationStatistics.maxCentroidShift = maxShift;
+	m_iterationStatistics.reassignedRatio = totalCount != 0 ? static_cast<float>(static_cast<double>(reassignedCount) / static_cast<double>(totalCount)) : 0.0f;
+	m_iterationStatistics.inertia = inertia > 0.0 ? inertia : 0.0;
+	m_iterationStatistics.repairedClusterCount = repairedClusterCount;
+
+}
+
+//Move every centroid by its learning rate towards the mean of its batch pixels, centroids without any stay in place
+void KMeans::MoveCentroidsTowardsBatchMeans() {
+
+	for (size_t i = 0; i < m_centroids.size(); ++i) {
+
+		uint64_t sumR = 0;
+		uint64_t sumG = 0;
+		uint64_t sumB = 0;
+		uint64_t sumCount = 0;
+
+		for (size_t j = 0; j < m_bandCentroidSums.size(); ++j) {
+
+			sumR += m_bandCentroidSums[j].r[i];
+			sumG += m_bandCentroidSums[j].g[i];
+			sumB += m_bandCentroidSums[j].b[i];
+			sumCount += m_bandCentroidSums[j].count[i];
+
+		}
+
+		if (sumCount == 0) continue;
+
+		m_miniBatchCounts[i] += sumCount;
+
+		float learningRate = static_cast<float>(static_cast<double>(sumCount) / static_cast<double>(m_miniBatchCounts[i]));
+		if (learningRate < m_miniBatchSettings.minLearningRate) learningRate = m_miniBatchSettings.minLearningRate;
+		if (learningRate > 1.0f) learningRate = 1.0f;
+
+		float scale = 1.0f / (255.0f * static_cast<float>(sumCount));
+
+		m_centroids[i].x += learningRate * (static_cast<float>(sumR) * scale - m_centroids[i].x);
+		m_centroids[i].y += learningRate * (static_cast<float>(sumG) * scale - m_centroids[i].y);
+		m_centroids[i].z += learningRate * (static_cast<float>(sumB) * scale - m_centroids[i].z);
+
+	}
+
+	UpdateCentroidTable();
+
+}
+
+//Also restarts the learning rates of the mini-batches
+void KMeans::InvalidateAssignments() {
+
+	m_arePreviousAssignmentsValid = false;
+	m_miniBatchCounts.assign(m_centroids.size(), 0);
+
+}
+
+//Mirror the centroids into the kernel layouts (channels in [0, 255] and rounded fixed point), their sRGB colors and the k-d tree
+void KMeans::UpdateCentroidTable() {
+
+	const float fixedScale = static_cast<float>(1 << FIXED_CENTROID_FRACTION_BITS);
+	const float fixedMax = static_cast<float>(255 << FIXED_CENTROID_FRACTION_BITS);
+
+	for (size_t i = 0; i < m_centroids.size(); ++i) {
+
+		m_centroidTableR[i] = m_centroids[i].x * 255.0f;
+		m_centroidTableG[i] = m_centroids[i].y * 255.0f;
+		m_centroidTableB[i] = m_centroids[i].z * 255.0f;
+		m_centroidPixels[i] = m_colorSpaceConverter->GetColorSpace() == COLOR_SPACE_RGB ? PackPixel(m_centroids[i]) : m_colorSpaceConverter->DecodeColor(m_centroids[i]);
+
+		uint32_t fixedR = static_cast<uint32_t>(std::fmin(std::fmax(m_centroidTableR[i] * fixedScale + 0.5f, 0.0f), fixedMax));
+		uint32_t fixedG = static_cast<uint32_t>(std::fmin(std::fmax(m_centroidTableG[i] * fixedScale + 0.5f, 0.0f), fixedMax));
+		uint32_t fixedB = static_cast<uint32_t>(std::fmin(std::fmax(m_centroidTableB[i] * fixedScale + 0.5f, 0.0f), fixedMax));
+		m_fixedCentroidTableRB[i] = (fixedR << 16) | fixedB;
+		m_fixedCentroidTableG[i] = fixedG;
+
+	}
+
+	if (m_algorithm == KMEANS_ALGORITHM_KD_TREE) {
+
+		CentroidTable centroidTable = { m_centroidTableR.data(), m_centroidTableG.data(), m_centroidTableB.data(), GetCentroidCount() };
+		m_kdTree->Build(centroidTable);
+
+	}
+
+	m_paletteLut->Clear();
+
+}
+
+//Assign the pixels, or the entries of their histogram, to the current centroids and sum them up per cluster
+//The squares of binned entries come from their means, which leaves out the spread inside the bins
+void KMeans::MeasureClusters(const uint32_t* pixels, size_t pixelCount, const ColorHistogram* histogram) {
+
+	m_entryAssignments.assign(pixelCount, 0xFFFFFFFF);
+	AssignFrame(pixels, pixelCount, nullptr, &m_bandCentroidSums, nullptr, histogram, m_entryAssignments.data());
+
+	m_clusterMoments.count.assign(m_centroids.size(), 0.0);
+	m_clusterMoments.r.assign(m_centroids.size(), 0.0);
+	m_clusterMoments.g.assign(m_centroids.size(), 0.0);
+	m_clusterMoments.b.assign(m_centroids.size(), 0.0);
+	m_clusterMoments.squaredR.assign(m_centroids.size(), 0.0);
+	m_clusterMoments.squaredG.assign(m_centroids.size(), 0.0);
+	m_clusterMoments.squaredB.assign(m_centroids.size(), 0.0);
+
+	const uint64_t* entrySumsR = histogram != nullptr ? histogram->GetEntrySumsR() : nullptr;
+	const uint64_t* entrySumsG = histogram != nullptr ? histogram->GetEntrySumsG() : nullptr;
+	const uint64_t* entrySumsB = histogram != nullptr ? histogram->GetEntrySumsB() : nullptr;
+	const uint32_t* entryCounts = histogram != nullptr ? histogram->GetEntryCounts() : nullptr;
+
+	for (size_t i = 0; i < pixelCount; ++i) {
+
+		uint32_t centroidIndex = m_entryAssignments[i];
+		double count = 1.0;
+		double sumR = static_cast<double>((pixels[i] >> 16) & 0xFF);
+		double sumG = static_cast<double>((pixels[i] >> 8) & 0xFF);
+		double sumB = static_cast<double>(pixels[i] & 0xFF);
+
+		if (histogram != nullptr) {
+
+			count = static_cast<double>(entryCounts[i]);
+			sumR = static_cast<double>(entrySumsR[i]);
+			sumG = static_cast<double>(entrySumsG[i]);
+			sumB = static_cast<double>(entrySumsB[i]);
+
+		}
+
+		m_clusterMoments.count[centroidIndex] += count;
+		m_clusterMoments.r[centroidIndex] += sumR;
+		m_clusterMoments.g[centroidIndex] += sumG;
+		m_clusterMoments.b[centroidIndex] += sumB;
+		m_clusterMoments.squaredR[centroidIndex] += sumR * sumR / count;
+		m_clusterMoments.squaredG[centroidIndex] += sumG * sumG / count;
+		m_clusterMoments.squaredB[centroidIndex] += sumB * sumB / count;
+
+	}
+
+}
+
+//Measured clusters with a positive squared error, at most clusterCount of them and the largest errors first
+std::vector<uint32_t> KMeans::FindLargestClusters(uint32_t clusterCount) const {
+
+	std::vector<std::pair<double, uint32_t>> clusterErrors;
+	for (uint32_t i = 0; i < GetCentroidCount(); ++i) {
+
+		if (m_clusterMoments.count[i] == 0.0) continue;
+
+		double error = m_clusterMoments.squaredR[i] + m_clusterMoments.squaredG[i] + m_clusterMoments.squaredB[i] -
+			(m_clusterMoments.r[i] * m_clusterMoments.r[i] + m_clusterMoments.g[i] * m_clusterMoments.g[i] + m_clusterMoments.b[i] * m_clusterMoments.b[i]) /
+			m_clusterMoments.count[i];
+		if (error > 0.0) clusterErrors.push_back(std::make_pair(error, i));
+
+	}
+
+	if (clusterCount > clusterErrors.size()) clusterCount = static_cast<uint32_t>(clusterErrors.size());
+	std::partial_sort(clusterErrors.begin(), clusterErrors.begin() + clusterCount, clusterErrors.end(), std::greater<std::pair<double, uint32_t>>());
+
+	std::vector<uint32_t> largestClusters(clusterCount);
+	for (uint32_t i = 0; i < clusterCount; ++i) largestClusters[i] = clusterErrors[i].second;
+
+	return largestClusters;
+
+}
+
+//The two halves of a measured cluster sit one standard deviation either side of its mean along the widest channel
+void KMeans::SplitCluster(uint32_t clusterIndex, uint32_t newClusterIndex) {
+
+	double count = m_clusterMoments.count[clusterIndex];
+	double meanR = m_clusterMoments.r[clusterIndex] / count;
+	double meanG = m_clusterMoments.g[clusterIndex] / count;
+	double meanB = m_clusterMoments.b[clusterIndex] / count;
+	double varianceR = m_clusterMoments.squaredR[clusterIndex] / count - meanR * meanR;
+	double varianceG = m_clusterMoments.squaredG[clusterIndex] / count - meanG * meanG;
+	double varianceB = m_clusterMoments.squaredB[clusterIndex] / count - meanB * meanB;
+
+	Point offset;
+	if (varianceR >= varianceG && varianceR >= varianceB) offset.x = static_cast<float>(std::sqrt(varianceR > 0.0 ? varianceR : 0.0) / 255.0);
+	else if (varianceG >= varianceB) offset.y = static_cast<float>(std::sqrt(varianceG > 0.0 ? varianceG : 0.0) / 255.0);
+	else offset.z = static_cast<float>(std::sqrt(varianceB > 0.0 ? varianceB : 0.0) / 255.0);
+
+	Point mean(static_cast<float>(meanR / 255.0), static_cast<float>(meanG / 255.0), static_cast<float>(meanB / 255.0));
+	m_centroids[clusterIndex] = Point(mean.x - offset.x, mean.y - offset.y, mean.z - offset.z);
+	m_centroids[newClusterIndex] = Point(mean.x + offset.x, mean.y + offset.y, mean.z + offset.z);
+
+}
+
+//Clusters are measured again with the moved centroids, a cluster emptied by the last assignment may have won pixels back
+//Every cluster still empty takes one half of a different large cluster, empty ones beyond the splittable clusters stay in place
+uint32_t KMeans::RepairEmptyClusters(const uint32_t* pixels, size_t pixelCount, const ColorHistogram* histogram) {
+
+	MeasureClusters(pixels, pixelCount, histogram);
+
+	std::vector<uint32_t> emptyClusters;
+	for (uint32_t i = 0; i < GetCentroidCount(); ++i) {
+
+		if (m_clusterMoments.count[i] == 0.0) emptyClusters.push_back(i);
+
+	}
+
+	std::vector<uint32_t> largestClusters = FindLargestClusters(static_cast<uint32_t>(emptyClusters.size()));
+	if (largestClusters.empty()) return 0;
+
+	for (size_t i = 0; i < largestClusters.size(); ++i) SplitCluster(largestClusters[i], emptyClusters[i]);
+
+	UpdateCentroidTable();
+
+	return static_cast<uint32_t>(largestClusters.size());
+
+}
+
+//Keeps the first centroids, new ones start at the origin - the bounds are sized for the centroid count and start over
+void KMeans::ResizeCentroids(uint32_t centroidCount) {
+
+	m_centroids.resize(centroidCount);
+	m_centroidTableR.resize(centroidCount);
+	m_centroidTableG.resize(centroidCount);
+	m_centroidTableB.resize(centroidCount);
+	m_centroidPixels.resize(centroidCount);
+	m_fixedCentroidTableRB.resize(centroidCount);
+	m_fixedCentroidTableG.resize(centroidCount);
+	m_previousCentroidTableR.resize(centroidCount);
+	m_previousCentroidTableG.resize(centroidCount);
+	m_previousCentroidTableB.resize(centroidCount);
+
+	m_bounds = std::make_unique<KMeansBounds>(centroidCount, m_simdLevel);
+	InvalidateAssignments();
+
+}
+
+}
@@ -0,0 +1,277 @@
+#include <kmeans_kernels.h>
+
+#include <immintrin.h>
+
+namespace VoronoiCore {
+
+namespace {
+
+//16 pixels per iteration as two independent 8 lane vectors so the compare/blend chains overlap, then 8, then scalar
+//Built without FMA so distances round exactly like the scalar kernel
+template <uint32_t CentroidCount>
+void AssignAVX2Count(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments) {
+
+	const uint32_t centroidCount = CentroidCount != 0 ? CentroidCount : centroids.count;
+
+	const __m256i channelMask = _mm256_set1_epi32(0xFF);
+	const __m256i one = _mm256_set1_epi32(1);
+
+	size_t i = 0;
+	for (; i + 16 <= pixelCount; i += 16) {
+
+		__m256i pixelA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+		__m256i pixelB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i + 8));
+		__m256 colorRA = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixelA, 16), channelMask));
+		__m256 colorGA = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixelA, 8), channelMask));
+		__m256 colorBA = _mm256_cvtepi32_ps(_mm256_and_si256(pixelA, channelMask));
+		__m256 colorRB = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixelB, 16), channelMask));
+		__m256 colorGB = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixelB, 8), channelMask));
+		__m256 colorBB = _mm256_cvtepi32_ps(_mm256_and_si256(pixelB, channelMask));
+
+		__m256 minDistanceA = _mm256_set1_ps(3.402823466e+38f);
+		__m256 minDistanceB = minDistanceA;
+		__m256i minDistanceIndexA = _mm256_setzero_si256();
+		__m256i minDistanceIndexB = minDistanceIndexA;
+		__m256i index = _mm256_setzero_si256();
+
+		for (uint32_t j = 0; j < centroidCount; ++j) {
+
+			__m256 centroidR = _mm256_set1_ps(centroids.r[j]);
+			__m256 centroidG = _mm256_set1_ps(centroids.g[j]);
+			__m256 centroidB = _mm256_set1_ps(centroids.b[j]);
+
+			__m256 distanceRA = _mm256_sub_ps(centroidR, colorRA);
+			__m256 distanceGA = _mm256_sub_ps(centroidG, colorGA);
+			__m256 distanceBA = _mm256_sub_ps(centroidB, colorBA);
+			__m256 distanceRB = _mm256_sub_ps(centroidR, colorRB);
+			__m256 distanceGB = _mm256_sub_ps(centroidG, colorGB);
+			__m256 distanceBB = _mm256_sub_ps(centroidB, colorBB);
+
+			__m256 distanceA = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(distanceRA, distanceRA), _mm256_mul_ps(distanceGA, distanceGA)), _mm256_mul_ps(distanceBA, distanceBA));
+			__m256 distanceB = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(distanceRB, distanceRB), _mm256_mul_ps(distanceGB, distanceGB)), _mm256_mul_ps(distanceBB, distanceBB));
+			__m256 closerA = _mm256_cmp_ps(distanceA, minDistanceA, _CMP_LT_OQ);
+			__m256 closerB = _mm256_cmp_ps(distanceB, minDistanceB, _CMP_LT_OQ);
+
+			minDistanceA = _mm256_blendv_ps(minDistanceA, distanceA, closerA);
+			minDistanceB = _mm256_blendv_ps(minDistanceB, distanceB, closerB);
+			minDistanceIndexA = _mm256_blendv_epi8(minDistanceIndexA, index, _mm256_castps_si256(closerA));
+			minDistanceIndexB = _mm256_blendv_epi8(minDistanceIndexB, index, _mm256_castps_si256(closerB));
+			index = _mm256_add_epi32(index, one);
+
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(assignments + i), minDistanceIndexA);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(assignments + i + 8), minDistanceIndexB);
+
+	}
+
+	for (; i + 8 <= pixelCount; i += 8) {
+
+		__m256i pixel = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+		__m256 colorR = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixel, 16), channelMask));
+		__m256 colorG = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixel, 8), channelMask));
+		__m256 colorB = _mm256_cvtepi32_ps(_mm256_and_si256(pixel, channelMask));
+
+		__m256 minDistance = _mm256_set1_ps(3.402823466e+38f);
+		__m256i minDistanceIndex = _mm256_setzero_si256();
+		__m256i index = _mm256_setzero_si256();
+
+		for (uint32_t j = 0; j < centroidCount; ++j) {
+
+			__m256 distanceR = _mm256_sub_ps(_mm256_set1_ps(centroids.r[j]), colorR);
+			__m256 distanceG = _mm256_sub_ps(_mm256_set1_ps(centroids.g[j]), colorG);
+			__m256 distanceB = _mm256_sub_ps(_mm256_set1_ps(centroids.b[j]), colorB);
+
+			__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(distanceR, distanceR), _mm256_mul_ps(distanceG, distanceG)), _mm256_mul_ps(distanceB, distanceB));
+			__m256 closer = _mm256_cmp_ps(distance, minDistance, _CMP_LT_OQ);
+
+			minDistance = _mm256_blendv_ps(minDistance, distance, closer);
+			minDistanceIndex = _mm256_blendv_epi8(minDistanceIndex, index, _mm256_castps_si256(closer));
+			index = _mm256_add_epi32(index, one);
+
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(assignments + i), minDistanceIndex);
+
+	}
+
+	AssignScalar(pixels + i, pixelCount - i, centroids, assignments + i);
+
+}
+
+}
+
+void AssignAVX2(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments) {
+
+	switch (centroids.count) {
+
+	case 8: AssignAVX2Count<8>(pixels, pixelCount, centroids, assignments); break;
+	case 16: AssignAVX2Count<16>(pixels, pixelCount, centroids, assignments); break;
+	case 32: AssignAVX2Count<32>(pixels, pixelCount, centroids, assignments); break;
+	case 64: AssignAVX2Count<64>(pixels, pixelCount, centroids, assignments); break;
+	case 128: AssignAVX2Count<128>(pixels, pixelCount, centroids, assignments); break;
+	case 256: AssignAVX2Count<256>(pixels, pixelCount, centroids, assignments); break;
+	default: AssignAVX2Count<0>(pixels, pixelCount, centroids, assignments); break;
+
+	}
+
+}
+
+void AssignTwoNearestAVX2(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments,
+	float* minDistances, float* secondMinDistances) {
+
+	const __m256i channelMask = _mm256_set1_epi32(0xFF);
+	const __m256i one = _mm256_set1_epi32(1);
+
+	size_t i = 0;
+	for (; i + 8 <= pixelCount; i += 8) {
+
+		__m256i pixel = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+		__m256 colorR = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixel, 16), channelMask));
+		__m256 colorG = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixel, 8), channelMask));
+		__m256 colorB = _mm256_cvtepi32_ps(_mm256_and_si256(pixel, channelMask));
+
+		__m256 minDistance = _mm256_set1_ps(3.402823466e+38f);
+		__m256 secondMinDistance = minDistance;
+		__m256i minDistanceIndex = _mm256_setzero_si256();
+		__m256i index = _mm256_setzero_si256();
+
+		for (uint32_t j = 0; j < centroids.count; ++j) {
+
+			__m256 distanceR = _mm256_sub_ps(_mm256_set1_ps(centroids.r[j]), colorR);
+			__m256 distanceG = _mm256_sub_ps(_mm256_set1_ps(centroids.g[j]), colorG);
+			__m256 distanceB = _mm256_sub_ps(_mm256_set1_ps(centroids.b[j]), colorB);
+
+			__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(distanceR, distanceR), _mm256_mul_ps(distanceG, distanceG)), _mm256_mul_ps(distanceB, distanceB));
+			__m256 closer = _mm256_cmp_ps(distance, minDistance, _CMP_LT_OQ);
+
+			//The old minimum or the new distance, whichever is larger, competes for second place
+			secondMinDistance = _mm256_min_ps(secondMinDistance, _mm256_max_ps(minDistance, distance));
+			minDistance = _mm256_blendv_ps(minDistance, distance, closer);
+			minDistanceIndex = _mm256_blendv_epi8(minDistanceIndex, index, _mm256_castps_si256(closer));
+			index = _mm256_add_epi32(index, one);
+
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(assignments + i), minDistanceIndex);
+		_mm256_storeu_ps(minDistances + i, minDistance);
+		_mm256_storeu_ps(secondMinDistances + i, secondMinDistance);
+
+	}
+
+	AssignTwoNearestScalar(pixels + i, pixelCount - i, centroids, assignments + i, minDistances + i, secondMinDistances + i);
+
+}
+
+namespace {
+
+//Fixed point centroids - the red/blue pair and the green channel of a pixel are two 16-bit lanes of its 32-bit lane each,
+//so 16-bit subtracts cover twice the lanes of the float kernel and pmaddwd squares and adds every pair in one instruction
+//The distances are unsigned, a strict minimum is min_epu32 not changing the current one
+template <uint32_t CentroidCount>
+void AssignFixedAVX2Count(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments) {
+
+	const uint32_t centroidCount = CentroidCount != 0 ? CentroidCount : centroids.count;
+
+	const __m256i pairMask = _mm256_set1_epi32(0x00FF00FF);
+	const __m256i channelMask = _mm256_set1_epi32(0xFF);
+	const __m256i one = _mm256_set1_epi32(1);
+
+	size_t i = 0;
+	for (; i + 16 <= pixelCount; i += 16) {
+
+		__m256i pixelA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+		__m256i pixelB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i + 8));
+		__m256i colorRBA = _mm256_slli_epi16(_mm256_and_si256(pixelA, pairMask), FIXED_CENTROID_FRACTION_BITS);
+		__m256i colorGA = _mm256_slli_epi32(_mm256_and_si256(_mm256_srli_epi32(pixelA, 8), channelMask), FIXED_CENTROID_FRACTION_BITS);
+		__m256i colorRBB = _mm256_slli_epi16(_mm256_and_si256(pixelB, pairMask), FIXED_CENTROID_FRACTION_BITS);
+		__m256i colorGB = _mm256_slli_epi32(_mm256_and_si256(_mm256_srli_epi32(pixelB, 8), channelMask), FIXED_CENTROID_FRACTION_BITS);
+
+		__m256i minDistanceA = _mm256_set1_epi32(-1);
+		__m256i minDistanceB = minDistanceA;
+		__m256i minDistanceIndexA = _mm256_setzero_si256();
+		__m256i minDistanceIndexB = minDistanceIndexA;
+		__m256i index = _mm256_setzero_si256();
+
+		for (uint32_t j = 0; j < centroidCount; ++j) {
+
+			__m256i centroidRB = _mm256_set1_epi32(static_cast<int>(centroids.rb[j]));
+			__m256i centroidG = _mm256_set1_epi32(static_cast<int>(centroids.g[j]));
+
+			__m256i distanceRBA = _mm256_sub_epi16(centroidRB, colorRBA);
+			__m256i distanceGA = _mm256_sub_epi16(centroidG, colorGA);
+			__m256i distanceRBB = _mm256_sub_epi16(centroidRB, colorRBB);
+			__m256i distanceGB = _mm256_sub_epi16(centroidG, colorGB);
+
+			__m256i distanceA = _mm256_add_epi32(_mm256_madd_epi16(distanceRBA, distanceRBA), _mm256_madd_epi16(distanceGA, distanceGA));
+			__m256i distanceB = _mm256_add_epi32(_mm256_madd_epi16(distanceRBB, distanceRBB), _mm256_madd_epi16(distanceGB, distanceGB));
+			__m256i nextMinDistanceA = _mm256_min_epu32(distanceA, minDistanceA);
+			__m256i nextMinDistanceB = _mm256_min_epu32(distanceB, minDistanceB);
+			__m256i notCloserA = _mm256_cmpeq_epi32(nextMinDistanceA, minDistanceA);
+			__m256i notCloserB = _mm256_cmpeq_epi32(nextMinDistanceB, minDistanceB);
+
+			minDistanceA = nextMinDistanceA;
+			minDistanceB = nextMinDistanceB;
+			minDistanceIndexA = _mm256_blendv_epi8(index, minDistanceIndexA, notCloserA);
+			minDistanceIndexB = _mm256_blendv_epi8(index, minDistanceIndexB, notCloserB);
+			index = _mm256_add_epi32(index, one);
+
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(assignments + i), minDistanceIndexA);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(assignments + i + 8), minDistanceIndexB);
+
+	}
+
+	for (; i + 8 <= pixelCount; i += 8) {
+
+		__m256i pixel = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+		__m256i colorRB = _mm256_slli_epi16(_mm256_and_si256(pixel, pairMask), FIXED_CENTROID_FRACTION_BITS);
+		__m256i colorG = _mm256_slli_epi32(_mm256_and_si256(_mm256_srli_epi32(pixel, 8), channelMask), FIXED_CENTROID_FRACTION_BITS);
+
+		__m256i minDistance = _mm256_set1_epi32(-1);
+		__m256i minDistanceIndex = _mm256_setzero_si256();
+		__m256i index = _mm256_setzero_si256();
+
+		for (uint32_t j = 0; j < centroidCount; ++j) {
+
+			__m256i distanceRB = _mm256_sub_epi16(_mm256_set1_epi32(static_cast<int>(centroids.rb[j])), colorRB);
+			__m256i distanceG = _mm256_sub_epi16(_mm256_set1_epi32(static_cast<int>(centroids.g[j])), colorG);
+
+			__m256i distance = _mm256_add_epi32(_mm256_madd_epi16(distanceRB, distanceRB), _mm256_madd_epi16(distanceG, distanceG));
+			__m256i nextMinDistance = _mm256_min_epu32(distance, minDistance);
+			__m256i notCloser = _mm256_cmpeq_epi32(nextMinDistance, minDistance);
+
+			minDistance = nextMinDistance;
+			minDistanceIndex = _mm256_blendv_epi8(index, minDistanceIndex, notCloser);
+			index = _mm256_add_epi32(index, one);
+
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(assignments + i), minDistanceIndex);
+
+	}
+
+	AssignFixedScalar(pixels + i, pixelCount - i, centroids, assignments + i);
+
+}
+
+}
+
+void AssignFixedAVX2(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments) {
+
+	switch (centroids.count) {
+
+	case 8: AssignFixedAVX2Count<8>(pixels, pixelCount, centroids, assignments); break;
+	case 16: AssignFixedAVX2Count<16>(pixels, pixelCount, centroids, assignments); break;
+	case 32: AssignFixedAVX2Count<32>(pixels, pixelCount, centroids, assignments); break;
+	case 64: AssignFixedAVX2Count<64>(pixels, pixelCount, centroids, assignments); break;
+	case 128: AssignFixedAVX2Count<128>(pixels, pixelCount, centroids, assignments); break;
+	case 256: AssignFixedAVX2Count<256>(pixels, pixelCount, centroids, assignments); break;
+	default: AssignFixedAVX2Count<0>(pixels, pixelCount, centroids, assignments); break;
+
+	}
+
+}
+
+}
@@ -0,0 +1,299 @@
+#include <kmeans_bounds.h>
+
+#include <cmath>
+#include <functional>
+
+namespace VoronoiCore {
+
+namespace {
+
+//Pixels gathered for one call of the full search kernel
+const size_t SEARCH_BATCH_SIZE = 256;
+
+//Bounds only skip a search with this margin (in [0, 255] channel units) to absorb float rounding of the bounds
+const float BOUND_EPSILON = 1.0e-3f;
+
+float SquaredDistance(const CentroidTable& centroids, uint32_t centroidIndex, float colorR, float colorG, float colorB) {
+
+	float distanceR = centroids.r[centroidIndex] - colorR;
+	float distanceG = centroids.g[centroidIndex] - colorG;
+	float distanceB = centroids.b[centroidIndex] - colorB;
+
+	return distanceR * distanceR + distanceG * distanceG + distanceB * distanceB;
+
+}
+
+}
+
+KMeansBounds::KMeansBounds(uint32_t centroidCount, SimdLevel simdLevel) :
+	m_centroidCount(centroidCount),
+	m_assignTwoNearestKernel(GetAssignTwoNearestKernel(simdLevel)),
+	m_algorithm(KMEANS_ALGORITHM_HAMERLY),
+	m_areBoundsValid(false),
+	m_pixels(nullptr),
+	m_pixelCount(0),
+	m_centroidDrift(centroidCount, 0.0f),
+	m_maxDriftIndex(0),
+	m_maxDrift(0.0f),
+	m_secondMaxDrift(0.0f),
+	m_centroidDistances(static_cast<size_t>(centroidCount) * centroidCount, 0.0f),
+	m_centroidHalfMinDistances(centroidCount, 0.0f) {}
+
+KMeansBounds::~KMeansBounds() {}
+
+void KMeansBounds::Invalidate() {
+
+	m_areBoundsValid = false;
+
+}
+
+void KMeansBounds::BeginPass(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, KMeansAlgorithm algorithm) {
+
+	//Bounds only carry over between passes over the same frame
+	if (pixels != m_pixels || pixelCount != m_pixelCount || algorithm != m_algorithm) m_areBoundsValid = false;
+
+	m_algorithm = algorithm;
+	m_pixels = pixels;
+	m_pixelCount = pixelCount;
+
+	m_pixelAssignments.resize(pixelCount);
+	m_pixelUpperBounds.resize(pixelCount);
+	m_pixelLowerBounds.resize(algorithm == KMEANS_ALGORITHM_ELKAN ? pixelCount * m_centroidCount : pixelCount);
+
+	if (!m_areBoundsValid) {
+
+		for (uint32_t i = 0; i < m_centroidCount; ++i) m_centroidDrift[i] = 0.0f;
+		m_maxDriftIndex = 0;
+		m_maxDrift = 0.0f;
+		m_secondMaxDrift = 0.0f;
+
+	}
+
+	for (uint32_t i = 0; i < m_centroidCount; ++i) {
+
+		float minDistance = 3.402823466e+38f;
+
+		for (uint32_t j = 0; j < m_centroidCount; ++j) {
+
+			float distance = std::sqrt(SquaredDistance(centroids, j, centroids.r[i], centroids.g[i], centroids.b[i]));
+			m_centroidDistances[static_cast<size_t>(i) * m_centroidCount + j] = distance;
+			if (j != i && distance < minDistance) minDistance = distance;
+
+		}
+
+		m_centroidHalfMinDistances[i] = 0.5f * minDistance;
+
+	}
+
+}
+
+const uint32_t* KMeansBounds::AssignBlock(size_t blockStart, size_t blockSize, const CentroidTable& centroids) {
+
+	if (m_algorithm == KMEANS_ALGORITHM_ELKAN) {
+
+		AssignBlockElkan(blockStart, blockSize, centroids);
+
+	}
+	else {
+
+		AssignBlockHamerly(blockStart, blockSize, centroids);
+
+	}
+
+	return m_pixelAssignments.data() + blockStart;
+
+}
+
+void KMeansBounds::EndPass(const CentroidTable& previousCentroids, const CentroidTable& centroids) {
+
+	m_maxDriftIndex = 0;
+	m_maxDrift = 0.0f;
+	m_secondMaxDrift = 0.0f;
+
+	for (uint32_t i = 0; i < m_centroidCount; ++i) {
+
+		float drift = std::sqrt(SquaredDistance(centroids, i, previousCentroids.r[i], previousCentroids.g[i], previousCentroids.b[i]));
+		m_centroidDrift[i] = drift;
+
+		if (drift > m_maxDrift) {
+
+			m_secondMaxDrift = m_maxDrift;
+			m_maxDrift = drift;
+			m_maxDriftIndex = i;
+
+		}
+		else if (drift > m_secondMaxDrift) {
+
+			m_secondMaxDrift = drift;
+
+		}
+
+	}
+
+	m_areBoundsValid = true;
+
+}
+
+KMeansAlgorithm KMeansBounds::GetAlgorithm() const {
+
+	return m_algorithm;
+
+}
+
+void KMeansBounds::AssignBlockHamerly(size_t blockStart, size_t blockSize, const CentroidTable& centroids) {
+
+	uint32_t searchPixels[SEARCH_BATCH_SIZE];
+	size_t searchIndices[SEARCH_BATCH_SIZE];
+	uint32_t searchAssignments[SEARCH_BATCH_SIZE];
+	float searchMinDistances[SEARCH_BATCH_SIZE];
+	float searchSecondMinDistances[SEARCH_BATCH_SIZE];
+	size_t searchCount = 0;
+
+	std::function<void()> searchBatch = [&]() {
+
+		m_assignTwoNearestKernel(searchPixels, searchCount, centroids, searchAssignments, searchMinDistances, searchSecondMinDistances);
+
+		for (size_t j = 0; j < searchCount; ++j) {
+
+			m_pixelAssignments[searchIndices[j]] = searchAssignments[j];
+			m_pixelUpperBounds[searchIndices[j]] = std::sqrt(searchMinDistances[j]);
+			m_pixelLowerBounds[searchIndices[j]] = std::sqrt(searchSecondMinDistances[j]);
+
+		}
+
+	};
+
+	for (size_t i = blockStart; i < blockStart + blockSize; ++i) {
+
+		if (m_areBoundsValid) {
+
+			float colorR = static_cast<float>((m_pixels[i] >> 16) & 0xFF);
+			float colorG = static_cast<float>((m_pixels[i] >> 8) & 0xFF);
+			float colorB = static_cast<float>(m_pixels[i] & 0xFF);
+
+			//Move the bounds by how far the centroids moved since they were set
+			uint32_t assignment = m_pixelAssignments[i];
+			float upperBound = m_pixelUpperBounds[i] + m_centroidDrift[assignment];
+			float lowerBound = m_pixelLowerBounds[i] - (assignment == m_maxDriftIndex ? m_secondMaxDrift : m_maxDrift);
+			float skipBound = lowerBound > m_centroidHalfMinDistances[assignment] ? lowerBound : m_centroidHalfMinDistances[assignment];
+
+			m_pixelUpperBounds[i] = upperBound;
+			m_pixelLowerBounds[i] = lowerBound;
+			if (upperBound + BOUND_EPSILON < skipBound) continue;
+
+			//Tighten the upper bound before searching every centroid
+			upperBound = std::sqrt(SquaredDistance(centroids, assignment, colorR, colorG, colorB));
+			m_pixelUpperBounds[i] = upperBound;
+			if (upperBound + BOUND_EPSILON < skipBound) continue;
+
+		}
+
+		searchPixels[searchCount] = m_pixels[i];
+		searchIndices[searchCount] = i;
+		searchCount++;
+
+		if (searchCount == SEARCH_BATCH_SIZE) {
+
+			searchBatch();
+			searchCount = 0;
+
+		}
+
+	}
+
+	if (searchCount != 0) searchBatch();
+
+}
+
+void KMeansBounds::AssignBlockElkan(size_t blockStart, size_t blockSize, const CentroidTable& centroids) {
+
+	for (size_t i = blockStart; i < blockStart + blockSize; ++i) {
+
+		float colorR = static_cast<float>((m_pixels[i] >> 16) & 0xFF);
+		float colorG = static_cast<float>((m_pixels[i] >> 8) & 0xFF);
+		float colorB = static_cast<float>(m_pixels[i] & 0xFF);
+
+		float* lowerBounds = m_pixelLowerBounds.data() + i * m_centroidCount;
+
+		if (!m_areBoundsValid) {
+
+			float minDistance = 3.402823466e+38f;
+			uint32_t minDistanceIndex = 0;
+
+			for (uint32_t j = 0; j < m_centroidCount; ++j) {
+
+				float distance = SquaredDistance(centroids, j, colorR, colorG, colorB);
+				lowerBounds[j] = std::sqrt(distance);
+				if (distance < minDistance) {
+
+					minDistance = distance;
+					minDistanceIndex = j;
+
+				}
+
+			}
+
+			m_pixelAssignments[i] = minDistanceIndex;
+			m_pixelUpperBounds[i] = std::sqrt(minDistance);
+			continue;
+
+		}
+
+		uint32_t assignment = m_pixelAssignments[i];
+		float upperBound = m_pixelUpperBounds[i] + m_centroidDrift[assignment];
+		for (uint32_t j = 0; j < m_centroidCount; ++j) {
+
+			float lowerBound = lowerBounds[j] - m_centroidDrift[j];
+			lowerBounds[j] = lowerBound > 0.0f ? lowerBound : 0.0f;
+
+		}
+
+		if (upperBound + BOUND_EPSILON < m_centroidHalfMinDistances[assignment]) {
+
+			m_pixelUpperBounds[i] = upperBound;
+			continue;
+
+		}
+
+		bool isUpperBoundTight = false;
+		float upperBoundSquared = 0.0f;
+
+		for (uint32_t j = 0; j < m_centroidCount; ++j) {
+
+			if (j == assignment) continue;
+
+			const float* assignmentDistances = m_centroidDistances.data() + static_cast<size_t>(assignment) * m_centroidCount;
+			float skipBound = lowerBounds[j] > 0.5f * assignmentDistances[j] ? lowerBounds[j] : 0.5f * assignmentDistances[j];
+			if (upperBound + BOUND_EPSILON < skipBound) continue;
+
+			if (!isUpperBoundTight) {
+
+				upperBoundSquared = SquaredDistance(centroids, assignment, colorR, colorG, colorB);
+				upperBound = std::sqrt(upperBoundSquared);
+				lowerBounds[assignment] = upperBound;
+				isUpperBoundTight = true;
+				if (upperBound + BOUND_EPSILON < skipBound) continue;
+
+			}
+
+			//Same tie break as the brute force search - the lower index wins between equal distances
+			float distance = SquaredDistance(centroids, j, colorR, colorG, colorB);
+			lowerBounds[j] = std::sqrt(distance);
+			if (distance < upperBoundSquared || (distance == upperBoundSquared && j < assignment)) {
+
+				assignment = j;
+				upperBoundSquared = distance;
+				upperBound = lowerBounds[j];
+
+			}
+
+		}
+
+		m_pixelAssignments[i] = assignment;
+		m_pixelUpperBounds[i] = upperBound;
+
+	}
+
+}
+
+}
@@ -0,0 +1,139 @@
+#include <kmeans_convergence.h>
+
+namespace VoronoiCore {
+
+ConvergenceMonitor::ConvergenceMonitor(const ConvergenceTolerance& tolerance) :
+	m_tolerance(tolerance),
+	m_iterationCount(0),
+	m_continuedIterationCount(0),
+	m_repairedClusterCount(0),
+	m_lastStatistics({ -1.0f, -1.0f, -1.0, 0 }),
+	m_previousInertia(-1.0),
+	m_hasConverged(false),
+	m_isFrameCounted(false),
+	m_finishedFrameCount(0),
+	m_finishedIterationCount(0),
+	m_lastFrameIterationCount(0) {}
+
+ConvergenceMonitor::~ConvergenceMonitor() {}
+
+void ConvergenceMonitor::Reset() {
+
+	m_iterationCount = 0;
+	m_continuedIterationCount = 0;
+	m_repairedClusterCount = 0;
+	m_lastStatistics = { -1.0f, -1.0f, -1.0, 0 };
+	m_previousInertia = -1.0;
+	m_hasConverged = false;
+	m_isFrameCounted = false;
+
+}
+
+void ConvergenceMonitor::AddIteration(const IterationStatistics& statistics) {
+
+	m_iterationCount++;
+	m_lastStatistics = statistics;
+
+	if (m_tolerance.maxCentroidShift > 0.0f && statistics.maxCentroidShift >= 0.0f && statistics.maxCentroidShift <= m_tolerance.maxCentroidShift) {
+
+		m_hasConverged = true;
+
+	}
+
+	if (m_tolerance.reassignedRatio > 0.0f && statistics.reassignedRatio >= 0.0f && statistics.reassignedRatio <= m_tolerance.reassignedRatio) {
+
+		m_hasConverged = true;
+
+	}
+
+	//The inertia criterion needs the previous iteration of the same frame
+	if (m_tolerance.inertiaDelta > 0.0f && statistics.inertia >= 0.0 && m_previousInertia > 0.0) {
+
+		double inertiaDelta = (m_previousInertia - statistics.inertia) / m_previousInertia;
+		if (inertiaDelta <= static_cast<double>(m_tolerance.inertiaDelta)) m_hasConverged = true;
+
+	}
+
+	//Repaired centroids start over in new clusters, the iteration that moved them never converges
+	m_repairedClusterCount += statistics.repairedClusterCount;
+	if (statistics.repairedClusterCount != 0) m_hasConverged = false;
+
+	m_previousInertia = statistics.inertia;
+
+	if (IsFinished() && !m_isFrameCounted) {
+
+		m_finishedFrameCount++;
+		m_finishedIterationCount += GetIterationCount();
+		m_lastFrameIterationCount = GetIterationCount();
+		m_isFrameCounted = true;
+
+	}
+
+}
+
+void ConvergenceMonitor::ContinueFrame() {
+
+	if (m_isFrameCounted) {
+
+		m_finishedFrameCount--;
+		m_finishedIterationCount -= GetIterationCount();
+		m_isFrameCounted = false;
+
+	}
+
+	m_continuedIterationCount += m_iterationCount;
+	m_iterationCount = 0;
+	m_previousInertia = -1.0;
+	m_hasConverged = false;
+
+}
+
+bool ConvergenceMonitor::HasConverged() const {
+
+	return m_hasConverged;
+
+}
+
+bool ConvergenceMonitor::IsFinished() const {
+
+	return m_hasConverged || m_iterationCount >= m_tolerance.maxIterationCount;
+
+}
+
+uint32_t ConvergenceMonitor::GetIterationCount() const {
+
+	return m_continuedIterationCount + m_iterationCount;
+
+}
+
+const IterationStatistics& ConvergenceMonitor::GetLastStatistics() const {
+
+	return m_lastStatistics;
+
+}
+
+uint32_t ConvergenceMonitor::GetRepairedClusterCount() const {
+
+	return m_repairedClusterCount;
+
+}
+
+uint64_t ConvergenceMonitor::GetFinishedFrameCount() const {
+
+	return m_finishedFrameCount;
+
+}
+
+uint32_t ConvergenceMonitor::GetLastFrameIterationCount() const {
+
+	return m_lastFrameIterationCount;
+
+}
+
+double ConvergenceMonitor::GetAverageIterationCount() const {
+
+	return m_finishedFrameCount == 0 ? 0.0 : static_cast<double>(m_finishedIterationCount) / static_cast<double>(m_finishedFrameCount);
+
+}
+
+}
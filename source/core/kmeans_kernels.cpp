@@ -0,0 +1,207 @@
+#include <kmeans_kernels.h>
+
+namespace VoronoiCore {
+
+namespace {
+
+template <uint32_t CentroidCount>
+void AssignScalarCount(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments) {
+
+	const uint32_t centroidCount = CentroidCount != 0 ? CentroidCount : centroids.count;
+
+	for (size_t i = 0; i < pixelCount; ++i) {
+
+		float colorR = static_cast<float>((pixels[i] >> 16) & 0xFF);
+		float colorG = static_cast<float>((pixels[i] >> 8) & 0xFF);
+		float colorB = static_cast<float>(pixels[i] & 0xFF);
+
+		float minDistance = 3.402823466e+38f;
+		uint32_t minDistanceIndex = 0;
+
+		for (uint32_t j = 0; j < centroidCount; ++j) {
+
+			float distanceR = centroids.r[j] - colorR;
+			float distanceG = centroids.g[j] - colorG;
+			float distanceB = centroids.b[j] - colorB;
+
+			float distance = distanceR * distanceR + distanceG * distanceG + distanceB * distanceB;
+			if (distance < minDistance) {
+
+				minDistance = distance;
+				minDistanceIndex = j;
+
+			}
+
+		}
+
+		assignments[i] = minDistanceIndex;
+
+	}
+
+}
+
+}
+
+void AssignScalar(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments) {
+
+	//Only counts the unrolled loop measurably speeds up are specialized, at 16 and above the unrolled minimum search is no faster
+	//than the loop over the table count and at 16 it is much slower
+	switch (centroids.count) {
+
+	case 8: AssignScalarCount<8>(pixels, pixelCount, centroids, assignments); break;
+	default: AssignScalarCount<0>(pixels, pixelCount, centroids, assignments); break;
+
+	}
+
+}
+
+void AssignTwoNearestScalar(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments,
+	float* minDistances, float* secondMinDistances) {
+
+	for (size_t i = 0; i < pixelCount; ++i) {
+
+		float colorR = static_cast<float>((pixels[i] >> 16) & 0xFF);
+		float colorG = static_cast<float>((pixels[i] >> 8) & 0xFF);
+		float colorB = static_cast<float>(pixels[i] & 0xFF);
+
+		float minDistance = 3.402823466e+38f;
+		float secondMinDistance = 3.402823466e+38f;
+		uint32_t minDistanceIndex = 0;
+
+		for (uint32_t j = 0; j < centroids.count; ++j) {
+
+			float distanceR = centroids.r[j] - colorR;
+			float distanceG = centroids.g[j] - colorG;
+			float distanceB = centroids.b[j] - colorB;
+
+			float distance = distanceR * distanceR + distanceG * distanceG + distanceB * distanceB;
+			if (distance < minDistance) {
+
+				secondMinDistance = minDistance;
+				minDistance = distance;
+				minDistanceIndex = j;
+
+			}
+			else if (distance < secondMinDistance) {
+
+				secondMinDistance = distance;
+
+			}
+
+		}
+
+		assignments[i] = minDistanceIndex;
+		minDistances[i] = minDistance;
+		secondMinDistances[i] = secondMinDistance;
+
+	}
+
+}
+
+namespace {
+
+//The squares of 16-bit differences fit in 32 bits signed, only their sum needs the unsigned range
+template <uint32_t CentroidCount>
+void AssignFixedScalarCount(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments) {
+
+	const uint32_t centroidCount = CentroidCount != 0 ? CentroidCount : centroids.count;
+
+	for (size_t i = 0; i < pixelCount; ++i) {
+
+		int32_t colorR = static_cast<int32_t>((pixels[i] >> 16) & 0xFF) << FIXED_CENTROID_FRACTION_BITS;
+		int32_t colorG = static_cast<int32_t>((pixels[i] >> 8) & 0xFF) << FIXED_CENTROID_FRACTION_BITS;
+		int32_t colorB = static_cast<int32_t>(pixels[i] & 0xFF) << FIXED_CENTROID_FRACTION_BITS;
+
+		uint32_t minDistance = 0xFFFFFFFF;
+		uint32_t minDistanceIndex = 0;
+
+		for (uint32_t j = 0; j < centroidCount; ++j) {
+
+			int32_t distanceR = static_cast<int32_t>(centroids.rb[j] >> 16) - colorR;
+			int32_t distanceG = static_cast<int32_t>(centroids.g[j]) - colorG;
+			int32_t distanceB = static_cast<int32_t>(centroids.rb[j] & 0xFFFF) - colorB;
+
+			uint32_t distance = static_cast<uint32_t>(distanceR * distanceR) + static_cast<uint32_t>(distanceG * distanceG) + static_cast<uint32_t>(distanceB * distanceB);
+			if (distance < minDistance) {
+
+				minDistance = distance;
+				minDistanceIndex = j;
+
+			}
+
+		}
+
+		assignments[i] = minDistanceIndex;
+
+	}
+
+}
+
+}
+
+void AssignFixedScalar(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments) {
+
+	//Like the float kernel only the small counts gain from unrolling
+	switch (centroids.count) {
+
+	case 8: AssignFixedScalarCount<8>(pixels, pixelCount, centroids, assignments); break;
+	case 16: AssignFixedScalarCount<16>(pixels, pixelCount, centroids, assignments); break;
+	default: AssignFixedScalarCount<0>(pixels, pixelCount, centroids, assignments); break;
+
+	}
+
+}
+
+//Fall back to the scalar kernel for instruction sets missing from this build
+AssignKernel GetAssignKernel(SimdLevel simdLevel) {
+
+	switch (simdLevel) {
+
+#if defined(VORONOI_CORE_X86)
+	case SIMD_LEVEL_AVX2: return AssignAVX2;
+	case SIMD_LEVEL_SSE41: return AssignSSE41;
+#endif
+#if defined(VORONOI_CORE_NEON)
+	case SIMD_LEVEL_NEON: return AssignNEON;
+#endif
+	default: return AssignScalar;
+
+	}
+
+}
+
+AssignTwoNearestKernel GetAssignTwoNearestKernel(SimdLevel simdLevel) {
+
+	switch (simdLevel) {
+
+#if defined(VORONOI_CORE_X86)
+	case SIMD_LEVEL_AVX2: return AssignTwoNearestAVX2;
+	case SIMD_LEVEL_SSE41: return AssignTwoNearestSSE41;
+#endif
+#if defined(VORONOI_CORE_NEON)
+	case SIMD_LEVEL_NEON: return AssignTwoNearestNEON;
+#endif
+	default: return AssignTwoNearestScalar;
+
+	}
+
+}
+
+AssignFixedKernel GetAssignFixedKernel(SimdLevel simdLevel) {
+
+	switch (simdLevel) {
+
+#if defined(VORONOI_CORE_X86)
+	case SIMD_LEVEL_AVX2: return AssignFixedAVX2;
+	case SIMD_LEVEL_SSE41: return AssignFixedSSE41;
+#endif
+#if defined(VORONOI_CORE_NEON)
+	case SIMD_LEVEL_NEON: return AssignFixedNEON;
+#endif
+	default: return AssignFixedScalar;
+
+	}
+
+}
+
+}
@@ -0,0 +1,49 @@
+#include <kmeans_mini_batch.h>
+
+namespace VoronoiCore {
+
+MiniBatchSampler::MiniBatchSampler(uint64_t seed) :
+	m_random(seed) {}
+
+MiniBatchSampler::~MiniBatchSampler() {}
+
+void MiniBatchSampler::SetSeed(uint64_t seed) {
+
+	m_random.SetSeed(seed);
+
+}
+
+void MiniBatchSampler::Sample(MiniBatchSampling sampling, const uint32_t* pixels, size_t pixelCount, size_t batchSize, uint32_t* batchPixels) {
+
+	if (batchSize == 0 || pixelCount == 0) return;
+
+	if (sampling == MINI_BATCH_SAMPLING_RANDOM && batchSize < pixelCount) {
+
+		for (size_t i = 0; i < batchSize; ++i) {
+
+			size_t pixelIndex = static_cast<size_t>(m_random.NextDouble() * static_cast<double>(pixelCount));
+			batchPixels[i] = pixels[pixelIndex < pixelCount ? pixelIndex : pixelCount - 1];
+
+		}
+
+		return;
+
+	}
+
+	//The stride is rounded down so the batch always fits in the frame, batches larger than the frame repeat it
+	size_t stride = pixelCount / batchSize;
+	if (stride == 0) stride = 1;
+
+	size_t pixelIndex = static_cast<size_t>(m_random.NextDouble() * static_cast<double>(stride));
+	for (size_t i = 0; i < batchSize; ++i) {
+
+		batchPixels[i] = pixels[pixelIndex];
+
+		pixelIndex += stride;
+		if (pixelIndex >= pixelCount) pixelIndex -= pixelCount;
+
+	}
+
+}
+
+}
@@ -0,0 +1,183 @@
+#include <kmeans_kernels.h>
+
+#include <arm_neon.h>
+
+namespace VoronoiCore {
+
+namespace {
+
+//4 pixels per vector, centroids broadcast one at a time
+//Multiply and add are kept separate (no vfmaq) so distances round exactly like the scalar kernel
+template <uint32_t CentroidCount>
+void AssignNEONCount(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments) {
+
+	const uint32_t centroidCount = CentroidCount != 0 ? CentroidCount : centroids.count;
+
+	const uint32x4_t channelMask = vdupq_n_u32(0xFF);
+	const uint32x4_t one = vdupq_n_u32(1);
+
+	size_t i = 0;
+	for (; i + 4 <= pixelCount; i += 4) {
+
+		uint32x4_t pixel = vld1q_u32(pixels + i);
+		float32x4_t colorR = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(pixel, 16), channelMask));
+		float32x4_t colorG = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(pixel, 8), channelMask));
+		float32x4_t colorB = vcvtq_f32_u32(vandq_u32(pixel, channelMask));
+
+		float32x4_t minDistance = vdupq_n_f32(3.402823466e+38f);
+		uint32x4_t minDistanceIndex = vdupq_n_u32(0);
+		uint32x4_t index = vdupq_n_u32(0);
+
+		for (uint32_t j = 0; j < centroidCount; ++j) {
+
+			float32x4_t distanceR = vsubq_f32(vdupq_n_f32(centroids.r[j]), colorR);
+			float32x4_t distanceG = vsubq_f32(vdupq_n_f32(centroids.g[j]), colorG);
+			float32x4_t distanceB = vsubq_f32(vdupq_n_f32(centroids.b[j]), colorB);
+
+			float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_f32(distanceR, distanceR), vmulq_f32(distanceG, distanceG)), vmulq_f32(distanceB, distanceB));
+			uint32x4_t closer = vcltq_f32(distance, minDistance);
+
+			minDistance = vbslq_f32(closer, distance, minDistance);
+			minDistanceIndex = vbslq_u32(closer, index, minDistanceIndex);
+			index = vaddq_u32(index, one);
+
+		}
+
+		vst1q_u32(assignments + i, minDistanceIndex);
+
+	}
+
+	AssignScalar(pixels + i, pixelCount - i, centroids, assignments + i);
+
+}
+
+}
+
+void AssignNEON(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments) {
+
+	switch (centroids.count) {
+
+	case 8: AssignNEONCount<8>(pixels, pixelCount, centroids, assignments); break;
+	case 16: AssignNEONCount<16>(pixels, pixelCount, centroids, assignments); break;
+	case 32: AssignNEONCount<32>(pixels, pixelCount, centroids, assignments); break;
+	case 64: AssignNEONCount<64>(pixels, pixelCount, centroids, assignments); break;
+	case 128: AssignNEONCount<128>(pixels, pixelCount, centroids, assignments); break;
+	case 256: AssignNEONCount<256>(pixels, pixelCount, centroids, assignments); break;
+	default: AssignNEONCount<0>(pixels, pixelCount, centroids, assignments); break;
+
+	}
+
+}
+
+void AssignTwoNearestNEON(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments,
+	float* minDistances, float* secondMinDistances) {
+
+	const uint32x4_t channelMask = vdupq_n_u32(0xFF);
+	const uint32x4_t one = vdupq_n_u32(1);
+
+	size_t i = 0;
+	for (; i + 4 <= pixelCount; i += 4) {
+
+		uint32x4_t pixel = vld1q_u32(pixels + i);
+		float32x4_t colorR = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(pixel, 16), channelMask));
+		float32x4_t colorG = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(pixel, 8), channelMask));
+		float32x4_t colorB = vcvtq_f32_u32(vandq_u32(pixel, channelMask));
+
+		float32x4_t minDistance = vdupq_n_f32(3.402823466e+38f);
+		float32x4_t secondMinDistance = minDistance;
+		uint32x4_t minDistanceIndex = vdupq_n_u32(0);
+		uint32x4_t index = vdupq_n_u32(0);
+
+		for (uint32_t j = 0; j < centroids.count; ++j) {
+
+			float32x4_t distanceR = vsubq_f32(vdupq_n_f32(centroids.r[j]), colorR);
+			float32x4_t distanceG = vsubq_f32(vdupq_n_f32(centroids.g[j]), colorG);
+			float32x4_t distanceB = vsubq_f32(vdupq_n_f32(centroids.b[j]), colorB);
+
+			float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_f32(distanceR, distanceR), vmulq_f32(distanceG, distanceG)), vmulq_f32(distanceB, distanceB));
+			uint32x4_t closer = vcltq_f32(distance, minDistance);
+
+			//The old minimum or the new distance, whichever is larger, competes for second place
+			secondMinDistance = vminq_f32(secondMinDistance, vmaxq_f32(minDistance, distance));
+			minDistance = vbslq_f32(closer, distance, minDistance);
+			minDistanceIndex = vbslq_u32(closer, index, minDistanceIndex);
+			index = vaddq_u32(index, one);
+
+		}
+
+		vst1q_u32(assignments + i, minDistanceIndex);
+		vst1q_f32(minDistances + i, minDistance);
+		vst1q_f32(secondMinDistances + i, secondMinDistance);
+
+	}
+
+	AssignTwoNearestScalar(pixels + i, pixelCount - i, centroids, assignments + i, minDistances + i, secondMinDistances + i);
+
+}
+
+namespace {
+
+//4 pixels per vector in 16-bit channel lanes, vmull_s16 widens the squares - they fit in 32 bits signed, their sum unsigned
+template <uint32_t CentroidCount>
+void AssignFixedNEONCount(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments) {
+
+	const uint32_t centroidCount = CentroidCount != 0 ? CentroidCount : centroids.count;
+
+	const uint32x4_t channelMask = vdupq_n_u32(0xFF);
+	const uint32x4_t one = vdupq_n_u32(1);
+
+	size_t i = 0;
+	for (; i + 4 <= pixelCount; i += 4) {
+
+		uint32x4_t pixel = vld1q_u32(pixels + i);
+		int16x4_t colorR = vreinterpret_s16_u16(vshl_n_u16(vmovn_u32(vandq_u32(vshrq_n_u32(pixel, 16), channelMask)), FIXED_CENTROID_FRACTION_BITS));
+		int16x4_t colorG = vreinterpret_s16_u16(vshl_n_u16(vmovn_u32(vandq_u32(vshrq_n_u32(pixel, 8), channelMask)), FIXED_CENTROID_FRACTION_BITS));
+		int16x4_t colorB = vreinterpret_s16_u16(vshl_n_u16(vmovn_u32(vandq_u32(pixel, channelMask)), FIXED_CENTROID_FRACTION_BITS));
+
+		uint32x4_t minDistance = vdupq_n_u32(0xFFFFFFFF);
+		uint32x4_t minDistanceIndex = vdupq_n_u32(0);
+		uint32x4_t index = vdupq_n_u32(0);
+
+		for (uint32_t j = 0; j < centroidCount; ++j) {
+
+			int16x4_t distanceR = vsub_s16(vdup_n_s16(static_cast<int16_t>(centroids.rb[j] >> 16)), colorR);
+			int16x4_t distanceG = vsub_s16(vdup_n_s16(static_cast<int16_t>(centroids.g[j])), colorG);
+			int16x4_t distanceB = vsub_s16(vdup_n_s16(static_cast<int16_t>(centroids.rb[j] & 0xFFFF)), colorB);
+
+			uint32x4_t distance = vaddq_u32(vaddq_u32(vreinterpretq_u32_s32(vmull_s16(distanceR, distanceR)), vreinterpretq_u32_s32(vmull_s16(distanceG, distanceG))),
+				vreinterpretq_u32_s32(vmull_s16(distanceB, distanceB)));
+			uint32x4_t closer = vcltq_u32(distance, minDistance);
+
+			minDistance = vbslq_u32(closer, distance, minDistance);
+			minDistanceIndex = vbslq_u32(closer, index, minDistanceIndex);
+			index = vaddq_u32(index, one);
+
+		}
+
+		vst1q_u32(assignments + i, minDistanceIndex);
+
+	}
+
+	AssignFixedScalar(pixels + i, pixelCount - i, centroids, assignments + i);
+
+}
+
+}
+
+void AssignFixedNEON(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments) {
+
+	switch (centroids.count) {
+
+	case 8: AssignFixedNEONCount<8>(pixels, pixelCount, centroids, assignments); break;
+	case 16: AssignFixedNEONCount<16>(pixels, pixelCount, centroids, assignments); break;
+	case 32: AssignFixedNEONCount<32>(pixels, pixelCount, centroids, assignments); break;
+	case 64: AssignFixedNEONCount<64>(pixels, pixelCount, centroids, assignments); break;
+	case 128: AssignFixedNEONCount<128>(pixels, pixelCount, centroids, assignments); break;
+	case 256: AssignFixedNEONCount<256>(pixels, pixelCount, centroids, assignments); break;
+	default: AssignFixedNEONCount<0>(pixels, pixelCount, centroids, assignments); break;
+
+	}
+
+}
+
+}
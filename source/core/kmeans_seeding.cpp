@@ -0,0 +1,452 @@
+#include <kmeans_seeding.h>
+
+#include <algorithm>
+
+namespace VoronoiCore {
+
+namespace {
+
+//Colors kept for seeding - enough to find every color cluster worth a centroid, few enough for O(n * k) passes
+const size_t MAX_SAMPLE_COUNT = 16384;
+
+//k-means|| rounds and candidates drawn per round per centroid
+const uint32_t KMEANS_PARALLEL_ROUND_COUNT = 5;
+const uint32_t KMEANS_PARALLEL_OVERSAMPLING = 2;
+
+//Colors per k-means|| task
+const size_t SEED_BLOCK_SIZE = 4096;
+
+float SquaredDistance(float colorR, float colorG, float colorB, float otherR, float otherG, float otherB) {
+
+	float distanceR = colorR - otherR;
+	float distanceG = colorG - otherG;
+	float distanceB = colorB - otherB;
+
+	return distanceR * distanceR + distanceG * distanceG + distanceB * distanceB;
+
+}
+
+//Index whose cumulative value first exceeds target
+size_t PickCumulative(const std::vector<double>& values, size_t count, double target) {
+
+	double cumulative = 0.0;
+	for (size_t i = 0; i < count; ++i) {
+
+		cumulative += values[i];
+		if (target < cumulative) return i;
+
+	}
+
+	//Rounding of the running sum may leave the target just above the total
+	for (size_t i = count; i > 0; --i) if (values[i - 1] > 0.0) return i - 1;
+
+	return 0;
+
+}
+
+}
+
+void KMeansSeeder::ColorSet::Clear() {
+
+	r.clear();
+	g.clear();
+	b.clear();
+	weight.clear();
+
+}
+
+void KMeansSeeder::ColorSet::Add(float colorR, float colorG, float colorB, double colorWeight) {
+
+	r.push_back(colorR);
+	g.push_back(colorG);
+	b.push_back(colorB);
+	weight.push_back(colorWeight);
+
+}
+
+size_t KMeansSeeder::ColorSet::GetCount() const {
+
+	return r.size();
+
+}
+
+KMeansSeeder::KMeansSeeder(uint64_t seed, TaskScheduler* taskScheduler) : m_random(seed), m_taskScheduler(taskScheduler) {}
+
+KMeansSeeder::~KMeansSeeder() {}
+
+void KMeansSeeder::SetSeed(uint64_t seed) {
+
+	m_random.SetSeed(seed);
+
+}
+
+void KMeansSeeder::SeedUniform(uint32_t centroidCount, Point* centroids) {
+
+	for (uint32_t i = 0; i < centroidCount; ++i) {
+
+		centroids[i].x = m_random.NextFloat();
+		centroids[i].y = m_random.NextFloat();
+		centroids[i].z = m_random.NextFloat();
+
+	}
+
+}
+
+void KMeansSeeder::Seed(SeedingMethod method, const uint32_t* colors, const uint32_t* weights, size_t colorCount, uint32_t centroidCount, Point* centroids) {
+
+	if (method == SEEDING_METHOD_UNIFORM || colorCount == 0) {
+
+		SeedUniform(centroidCount, centroids);
+		return;
+
+	}
+
+	SampleColors(colors, weights, colorCount);
+	if (m_samples.GetCount() == 0) {
+
+		SeedUniform(centroidCount, centroids);
+		return;
+
+	}
+
+	if (method == SEEDING_METHOD_KMEANS_PARALLEL) {
+
+		SeedKMeansParallel(centroidCount, centroids);
+
+	}
+	else if (method == SEEDING_METHOD_MEDIAN_CUT) {
+
+		SeedMedianCut(centroidCount, centroids);
+
+	}
+	else {
+
+		SeedKMeansPlusPlus(m_samples, centroidCount, centroids);
+
+	}
+
+}
+
+//Systematic sampling - MAX_SAMPLE_COUNT evenly spaced picks along the cumulative weight, a color weighs as many picks as it got
+void KMeansSeeder::SampleColors(const uint32_t* colors, const uint32_t* weights, size_t colorCount) {
+
+	m_samples.Clear();
+
+	double totalWeight = 0.0;
+	for (size_t i = 0; i < colorCount; ++i) totalWeight += weights != nullptr ? static_cast<double>(weights[i]) : 1.0;
+
+	double step = colorCount <= MAX_SAMPLE_COUNT ? 0.0 : totalWeight / static_cast<double>(MAX_SAMPLE_COUNT);
+	double threshold = step * m_random.NextDouble();
+	double cumulative = 0.0;
+
+	for (size_t i = 0; i < colorCount; ++i) {
+
+		double weight = weights != nullptr ? static_cast<double>(weights[i]) : 1.0;
+		if (weight <= 0.0) continue;
+
+		float colorR = static_cast<float>((colors[i] >> 16) & 0xFF);
+		float colorG = static_cast<float>((colors[i] >> 8) & 0xFF);
+		float colorB = static_cast<float>(colors[i] & 0xFF);
+
+		if (step == 0.0) {
+
+			m_samples.Add(colorR, colorG, colorB, weight);
+			continue;
+
+		}
+
+		cumulative += weight;
+		uint32_t pickCount = 0;
+		while (threshold < cumulative) {
+
+			pickCount++;
+			threshold += step;
+
+		}
+
+		if (pickCount != 0) m_samples.Add(colorR, colorG, colorB, static_cast<double>(pickCount));
+
+	}
+
+}
+
+void KMeansSeeder::SeedKMeansPlusPlus(const ColorSet& colors, uint32_t centroidCount, Point* centroids) {
+
+	size_t colorCount = colors.GetCount();
+	if (colorCount == 0) {
+
+		SeedUniform(centroidCount, centroids);
+		return;
+
+	}
+
+	std::vector<double> distances(colorCount, 3.402823466e+38);
+	std::vector<double> probabilities(colorCount);
+
+	double totalWeight = 0.0;
+	for (size_t i = 0; i < colorCount; ++i) totalWeight += colors.weight[i];
+
+	for (uint32_t c = 0; c < centroidCount; ++c) {
+
+		//First pick by weight alone, then by weighted squared distance to the closest pick
+		double total = 0.0;
+		if (c != 0) {
+
+			for (size_t i = 0; i < colorCount; ++i) {
+
+				probabilities[i] = colors.weight[i] * distances[i];
+				total += probabilities[i];
+
+			}
+
+		}
+
+		size_t pick = 0;
+		if (total > 0.0) {
+
+			pick = PickCumulative(probabilities, colorCount, m_random.NextDouble() * total);
+
+		}
+		else if (totalWeight > 0.0) {
+
+			//Fewer distinct colors than centroids - the rest double up and stay empty
+			pick = PickCumulative(colors.weight, colorCount, m_random.NextDouble() * totalWeight);
+
+		}
+		else {
+
+			pick = static_cast<size_t>(m_random.NextUInt32() % colorCount);
+
+		}
+
+		centroids[c].x = colors.r[pick] / 255.0f;
+		centroids[c].y = colors.g[pick] / 255.0f;
+		centroids[c].z = colors.b[pick] / 255.0f;
+
+		for (size_t i = 0; i < colorCount; ++i) {
+
+			double distance = SquaredDistance(colors.r[i], colors.g[i], colors.b[i], colors.r[pick], colors.g[pick], colors.b[pick]);
+			if (distance < distances[i]) distances[i] = distance;
+
+		}
+
+	}
+
+}
+
+void KMeansSeeder::SeedKMeansParallel(uint32_t centroidCount, Point* centroids) {
+
+	size_t sampleCount = m_samples.GetCount();
+	m_sampleDistances.assign(sampleCount, 3.402823466e+38);
+	m_sampleNearest.assign(sampleCount, 0);
+	m_candidates.Clear();
+
+	//Distances to the candidates [firstCandidate, candidate count)
+	std::function<void(size_t)> updateDistances = [&](size_t firstCandidate) {
+
+		RunBlocks(sampleCount, [&](size_t blockStart, size_t blockEnd) {
+
+			for (size_t i = blockStart; i < blockEnd; ++i) {
+
+				for (size_t j = firstCandidate; j < m_candidates.GetCount(); ++j) {
+
+					double distance = SquaredDistance(m_samples.r[i], m_samples.g[i], m_samples.b[i], m_candidates.r[j], m_candidates.g[j], m_candidates.b[j]);
+					if (distance < m_sampleDistances[i]) {
+
+						m_sampleDistances[i] = distance;
+						m_sampleNearest[i] = static_cast<uint32_t>(j);
+
+					}
+
+				}
+
+			}
+
+		});
+
+	};
+
+	double totalWeight = 0.0;
+	for (size_t i = 0; i < sampleCount; ++i) totalWeight += m_samples.weight[i];
+
+	size_t first = PickCumulative(m_samples.weight, sampleCount, m_random.NextDouble() * totalWeight);
+	m_candidates.Add(m_samples.r[first], m_samples.g[first], m_samples.b[first], 0.0);
+	updateDistances(0);
+
+	std::vector<uint8_t> isPicked(sampleCount);
+	double oversampling = static_cast<double>(KMEANS_PARALLEL_OVERSAMPLING) * static_cast<double>(centroidCount);
+
+	for (uint32_t round = 0; round < KMEANS_PARALLEL_ROUND_COUNT; ++round) {
+
+		double cost = 0.0;
+		for (size_t i = 0; i < sampleCount; ++i) cost += m_samples.weight[i] * m_sampleDistances[i];
+		if (cost <= 0.0) break;
+
+		//Every color is drawn on its own, with a draw derived from its index so any thread split picks the same colors
+		uint64_t roundSeed = m_random.NextUInt64();
+		RunBlocks(sampleCount, [&](size_t blockStart, size_t blockEnd) {
+
+			for (size_t i = blockStart; i < blockEnd; ++i) {
+
+				double probability = oversampling * m_samples.weight[i] * m_sampleDistances[i] / cost;
+				isPicked[i] = HashToUnitDouble(roundSeed, i) < probability ? 1 : 0;
+
+			}
+
+		});
+
+		size_t firstCandidate = m_candidates.GetCount();
+		for (size_t i = 0; i < sampleCount; ++i) {
+
+			if (isPicked[i] != 0) m_candidates.Add(m_samples.r[i], m_samples.g[i], m_samples.b[i], 0.0);
+
+		}
+
+		updateDistances(firstCandidate);
+
+	}
+
+	//Every candidate weighs as much as the colors closest to it
+	for (size_t i = 0; i < sampleCount; ++i) m_candidates.weight[m_sampleNearest[i]] += m_samples.weight[i];
+
+	SeedKMeansPlusPlus(m_candidates, centroidCount, centroids);
+
+}
+
+void KMeansSeeder::SeedMedianCut(uint32_t centroidCount, Point* centroids) {
+
+	struct Box {
+
+		size_t first;
+		size_t count;
+		uint32_t axis;
+		double priority;
+
+	};
+
+	const std::vector<float>* channels[3] = { &m_samples.r, &m_samples.g, &m_samples.b };
+
+	//Boxes of a single color cannot be split, the heaviest and widest boxes are split first
+	std::function<Box(size_t, size_t)> makeBox = [&](size_t first, size_t count) {
+
+		Box box = { first, count, 0, 0.0 };
+		double weight = 0.0;
+		float maxExtent = 0.0f;
+
+		for (uint32_t axis = 0; axis < 3; ++axis) {
+
+			const std::vector<float>& channel = *channels[axis];
+			float minValue = channel[m_sampleOrder[first]];
+			float maxValue = minValue;
+			for (size_t i = first + 1; i < first + count; ++i) {
+
+				minValue = std::min(minValue, channel[m_sampleOrder[i]]);
+				maxValue = std::max(maxValue, channel[m_sampleOrder[i]]);
+
+			}
+
+			if (maxValue - minValue > maxExtent) {
+
+				maxExtent = maxValue - minValue;
+				box.axis = axis;
+
+			}
+
+		}
+
+		for (size_t i = first; i < first + count; ++i) weight += m_samples.weight[m_sampleOrder[i]];
+		box.priority = weight * static_cast<double>(maxExtent) * static_cast<double>(maxExtent);
+
+		return box;
+
+	};
+
+	size_t sampleCount = m_samples.GetCount();
+	m_sampleOrder.resize(sampleCount);
+	for (size_t i = 0; i < sampleCount; ++i) m_sampleOrder[i] = static_cast<uint32_t>(i);
+
+	std::vector<Box> boxes;
+	boxes.push_back(makeBox(0, sampleCount));
+
+	while (boxes.size() < centroidCount) {
+
+		size_t boxIndex = 0;
+		for (size_t i = 1; i < boxes.size(); ++i) if (boxes[i].priority > boxes[boxIndex].priority) boxIndex = i;
+		if (boxes[boxIndex].priority <= 0.0) break;
+
+		Box box = boxes[boxIndex];
+		const std::vector<float>& channel = *channels[box.axis];
+		std::sort(m_sampleOrder.begin() + box.first, m_sampleOrder.begin() + box.first + box.count,
+			[&channel](uint32_t a, uint32_t b) { return channel[a] < channel[b]; });
+
+		//Split at the weighted median, both halves keep at least one color
+		double boxWeight = 0.0;
+		for (size_t i = box.first; i < box.first + box.count; ++i) boxWeight += m_samples.weight[m_sampleOrder[i]];
+
+		double cumulative = 0.0;
+		size_t split = box.first + 1;
+		for (size_t i = box.first; i < box.first + box.count - 1; ++i) {
+
+			cumulative += m_samples.weight[m_sampleOrder[i]];
+			split = i + 1;
+			if (cumulative >= 0.5 * boxWeight) break;
+
+		}
+
+		boxes[boxIndex] = makeBox(box.first, split - box.first);
+		boxes.push_back(makeBox(split, box.first + box.count - split));
+
+	}
+
+	//Centroids at the weighted means of the boxes, boxes run out when the frame has fewer colors than centroids
+	for (uint32_t c = 0; c < centroidCount; ++c) {
+
+		const Box& box = boxes[c % boxes.size()];
+		double sumR = 0.0;
+		double sumG = 0.0;
+		double sumB = 0.0;
+		double weight = 0.0;
+
+		for (size_t i = box.first; i < box.first + box.count; ++i) {
+
+			uint32_t sample = m_sampleOrder[i];
+			sumR += m_samples.weight[sample] * m_samples.r[sample];
+			sumG += m_samples.weight[sample] * m_samples.g[sample];
+			sumB += m_samples.weight[sample] * m_samples.b[sample];
+			weight += m_samples.weight[sample];
+
+		}
+
+		centroids[c].x = static_cast<float>(sumR / (255.0 * weight));
+		centroids[c].y = static_cast<float>(sumG / (255.0 * weight));
+		centroids[c].z = static_cast<float>(sumB / (255.0 * weight));
+
+	}
+
+}
+
+void KMeansSeeder::RunBlocks(size_t itemCount, const std::function<void(size_t, size_t)>& block) const {
+
+	size_t blockCount = (itemCount + SEED_BLOCK_SIZE - 1) / SEED_BLOCK_SIZE;
+	std::function<void(uint32_t)> runBlock = [&](uint32_t blockIndex) {
+
+		size_t blockStart = static_cast<size_t>(blockIndex) * SEED_BLOCK_SIZE;
+		size_t blockEnd = blockStart + SEED_BLOCK_SIZE < itemCount ? blockStart + SEED_BLOCK_SIZE : itemCount;
+		block(blockStart, blockEnd);
+
+	};
+
+	if (m_taskScheduler != nullptr) {
+
+		m_taskScheduler->ParallelFor(static_cast<uint32_t>(blockCount), runBlock);
+
+	}
+	else {
+
+		for (uint32_t i = 0; i < blockCount; ++i) runBlock(i);
+
+	}
+
+}
+
+}
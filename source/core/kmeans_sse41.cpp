@@ -0,0 +1,181 @@
+#include <kmeans_kernels.h>
+
+#include <smmintrin.h>
+
+namespace VoronoiCore {
+
+namespace {
+
+//4 pixels per vector, centroids broadcast one at a time
+template <uint32_t CentroidCount>
+void AssignSSE41Count(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments) {
+
+	const uint32_t centroidCount = CentroidCount != 0 ? CentroidCount : centroids.count;
+
+	const __m128i channelMask = _mm_set1_epi32(0xFF);
+	const __m128i one = _mm_set1_epi32(1);
+
+	size_t i = 0;
+	for (; i + 4 <= pixelCount; i += 4) {
+
+		__m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+		__m128 colorR = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixel, 16), channelMask));
+		__m128 colorG = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixel, 8), channelMask));
+		__m128 colorB = _mm_cvtepi32_ps(_mm_and_si128(pixel, channelMask));
+
+		__m128 minDistance = _mm_set1_ps(3.402823466e+38f);
+		__m128i minDistanceIndex = _mm_setzero_si128();
+		__m128i index = _mm_setzero_si128();
+
+		for (uint32_t j = 0; j < centroidCount; ++j) {
+
+			__m128 distanceR = _mm_sub_ps(_mm_set1_ps(centroids.r[j]), colorR);
+			__m128 distanceG = _mm_sub_ps(_mm_set1_ps(centroids.g[j]), colorG);
+			__m128 distanceB = _mm_sub_ps(_mm_set1_ps(centroids.b[j]), colorB);
+
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(distanceR, distanceR), _mm_mul_ps(distanceG, distanceG)), _mm_mul_ps(distanceB, distanceB));
+			__m128 closer = _mm_cmplt_ps(distance, minDistance);
+
+			minDistance = _mm_blendv_ps(minDistance, distance, closer);
+			minDistanceIndex = _mm_blendv_epi8(minDistanceIndex, index, _mm_castps_si128(closer));
+			index = _mm_add_epi32(index, one);
+
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(assignments + i), minDistanceIndex);
+
+	}
+
+	AssignScalar(pixels + i, pixelCount - i, centroids, assignments + i);
+
+}
+
+}
+
+void AssignSSE41(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments) {
+
+	switch (centroids.count) {
+
+	case 8: AssignSSE41Count<8>(pixels, pixelCount, centroids, assignments); break;
+	case 16: AssignSSE41Count<16>(pixels, pixelCount, centroids, assignments); break;
+	case 32: AssignSSE41Count<32>(pixels, pixelCount, centroids, assignments); break;
+	case 64: AssignSSE41Count<64>(pixels, pixelCount, centroids, assignments); break;
+	case 128: AssignSSE41Count<128>(pixels, pixelCount, centroids, assignments); break;
+	case 256: AssignSSE41Count<256>(pixels, pixelCount, centroids, assignments); break;
+	default: AssignSSE41Count<0>(pixels, pixelCount, centroids, assignments); break;
+
+	}
+
+}
+
+void AssignTwoNearestSSE41(const uint32_t* pixels, size_t pixelCount, const CentroidTable& centroids, uint32_t* assignments,
+	float* minDistances, float* secondMinDistances) {
+
+	const __m128i channelMask = _mm_set1_epi32(0xFF);
+	const __m128i one = _mm_set1_epi32(1);
+
+	size_t i = 0;
+	for (; i + 4 <= pixelCount; i += 4) {
+
+		__m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+		__m128 colorR = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixel, 16), channelMask));
+		__m128 colorG = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixel, 8), channelMask));
+		__m128 colorB = _mm_cvtepi32_ps(_mm_and_si128(pixel, channelMask));
+
+		__m128 minDistance = _mm_set1_ps(3.402823466e+38f);
+		__m128 secondMinDistance = minDistance;
+		__m128i minDistanceIndex = _mm_setzero_si128();
+		__m128i index = _mm_setzero_si128();
+
+		for (uint32_t j = 0; j < centroids.count; ++j) {
+
+			__m128 distanceR = _mm_sub_ps(_mm_set1_ps(centroids.r[j]), colorR);
+			__m128 distanceG = _mm_sub_ps(_mm_set1_ps(centroids.g[j]), colorG);
+			__m128 distanceB = _mm_sub_ps(_mm_set1_ps(centroids.b[j]), colorB);
+
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(distanceR, distanceR), _mm_mul_ps(distanceG, distanceG)), _mm_mul_ps(distanceB, distanceB));
+			__m128 closer = _mm_cmplt_ps(distance, minDistance);
+
+			//The old minimum or the new distance, whichever is larger, competes for second place
+			secondMinDistance = _mm_min_ps(secondMinDistance, _mm_max_ps(minDistance, distance));
+			minDistance = _mm_blendv_ps(minDistance, distance, closer);
+			minDistanceIndex = _mm_blendv_epi8(minDistanceIndex, index, _mm_castps_si128(closer));
+			index = _mm_add_epi32(index, one);
+
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(assignments + i), minDistanceIndex);
+		_mm_storeu_ps(minDistances + i, minDistance);
+		_mm_storeu_ps(secondMinDistances + i, secondMinDistance);
+
+	}
+
+	AssignTwoNearestScalar(pixels + i, pixelCount - i, centroids, assignments + i, minDistances + i, secondMinDistances + i);
+
+}
+
+namespace {
+
+//4 pixels per vector, same lane layout as AssignFixedAVX2
+template <uint32_t CentroidCount>
+void AssignFixedSSE41Count(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments) {
+
+	const uint32_t centroidCount = CentroidCount != 0 ? CentroidCount : centroids.count;
+
+	const __m128i pairMask = _mm_set1_epi32(0x00FF00FF);
+	const __m128i channelMask = _mm_set1_epi32(0xFF);
+	const __m128i one = _mm_set1_epi32(1);
+
+	size_t i = 0;
+	for (; i + 4 <= pixelCount; i += 4) {
+
+		__m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+		__m128i colorRB = _mm_slli_epi16(_mm_and_si128(pixel, pairMask), FIXED_CENTROID_FRACTION_BITS);
+		__m128i colorG = _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(pixel, 8), channelMask), FIXED_CENTROID_FRACTION_BITS);
+
+		__m128i minDistance = _mm_set1_epi32(-1);
+		__m128i minDistanceIndex = _mm_setzero_si128();
+		__m128i index = _mm_setzero_si128();
+
+		for (uint32_t j = 0; j < centroidCount; ++j) {
+
+			__m128i distanceRB = _mm_sub_epi16(_mm_set1_epi32(static_cast<int>(centroids.rb[j])), colorRB);
+			__m128i distanceG = _mm_sub_epi16(_mm_set1_epi32(static_cast<int>(centroids.g[j])), colorG);
+
+			__m128i distance = _mm_add_epi32(_mm_madd_epi16(distanceRB, distanceRB), _mm_madd_epi16(distanceG, distanceG));
+			__m128i nextMinDistance = _mm_min_epu32(distance, minDistance);
+			__m128i notCloser = _mm_cmpeq_epi32(nextMinDistance, minDistance);
+
+			minDistance = nextMinDistance;
+			minDistanceIndex = _mm_blendv_epi8(index, minDistanceIndex, notCloser);
+			index = _mm_add_epi32(index, one);
+
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(assignments + i), minDistanceIndex);
+
+	}
+
+	AssignFixedScalar(pixels + i, pixelCount - i, centroids, assignments + i);
+
+}
+
+}
+
+void AssignFixedSSE41(const uint32_t* pixels, size_t pixelCount, const FixedCentroidTable& centroids, uint32_t* assignments) {
+
+	switch (centroids.count) {
+
+	case 8: AssignFixedSSE41Count<8>(pixels, pixelCount, centroids, assignments); break;
+	case 16: AssignFixedSSE41Count<16>(pixels, pixelCount, centroids, assignments); break;
+	case 32: AssignFixedSSE41Count<32>(pixels, pixelCount, centroids, assignments); break;
+	case 64: AssignFixedSSE41Count<64>(pixels, pixelCount, centroids, assignments); break;
+	case 128: AssignFixedSSE41Count<128>(pixels, pixelCount, centroids, assignments); break;
+	case 256: AssignFixedSSE41Count<256>(pixels, pixelCount, centroids, assignments); break;
+	default: AssignFixedSSE41Count<0>(pixels, pixelCount, centroids, assignments); break;
+
+	}
+
+}
+
+}
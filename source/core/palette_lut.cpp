@@ -0,0 +1,197 @@
+#include <palette_lut.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace VoronoiCore {
+
+namespace {
+
+const uint32_t BOUNDARY_CELL = 0x80000000;
+
+//Squared distance slack of the candidate test - far above the float rounding of squared distances in [0, 255] space,
+//so a pixel's float search never picks a centroid the corners ruled out
+const float CANDIDATE_MARGIN = 1.0f;
+
+float SquaredDistance(const float* centroidR, const float* centroidG, const float* centroidB, uint32_t centroidIndex, float colorR, float colorG, float colorB) {
+
+	float distanceR = centroidR[centroidIndex] - colorR;
+	float distanceG = centroidG[centroidIndex] - colorG;
+	float distanceB = centroidB[centroidIndex] - colorB;
+
+	return distanceR * distanceR + distanceG * distanceG + distanceB * distanceB;
+
+}
+
+}
+
+PaletteLut::PaletteLut() : m_gridBits(0), m_boundaryCellCount(0) {}
+
+PaletteLut::~PaletteLut() {}
+
+void PaletteLut::Build(const CentroidTable& centroids, uint32_t gridBits) {
+
+	m_gridBits = gridBits;
+	m_centroidR.assign(centroids.r, centroids.r + centroids.count);
+	m_centroidG.assign(centroids.g, centroids.g + centroids.count);
+	m_centroidB.assign(centroids.b, centroids.b + centroids.count);
+
+	uint32_t gridSize = 1u << gridBits;
+	uint32_t cellSize = 256u >> gridBits;
+	m_cells.resize(size_t(1) << (3 * gridBits));
+	m_candidates.clear();
+	m_boundaryCellCount = 0;
+
+	std::vector<float> centerDistances(centroids.count);
+	std::vector<uint32_t> cellCandidates;
+
+	//Farthest two colors of a cell
+	float cellDiagonal = std::sqrt(3.0f) * static_cast<float>(cellSize - 1);
+
+	for (uint32_t cellR = 0; cellR < gridSize; ++cellR) {
+		for (uint32_t cellG = 0; cellG < gridSize; ++cellG) {
+			for (uint32_t cellB = 0; cellB < gridSize; ++cellB) {
+
+				//The cell holds the integer colors [low, low + cellSize - 1] of every channel
+				float lowR = static_cast<float>(cellR * cellSize);
+				float lowG = static_cast<float>(cellG * cellSize);
+				float lowB = static_cast<float>(cellB * cellSize);
+				float highR = lowR + static_cast<float>(cellSize - 1);
+				float highG = lowG + static_cast<float>(cellSize - 1);
+				float highB = lowB + static_cast<float>(cellSize - 1);
+
+				//Closest centroid to the cell center
+				float centerR = 0.5f * (lowR + highR);
+				float centerG = 0.5f * (lowG + highG);
+				float centerB = 0.5f * (lowB + highB);
+				uint32_t centerCentroid = 0;
+				float minDistance = 3.402823466e+38f;
+				for (uint32_t j = 0; j < centroids.count; ++j) {
+
+					float distance = SquaredDistance(centroids.r, centroids.g, centroids.b, j, centerR, centerG, centerB);
+					centerDistances[j] = distance;
+					if (distance < minDistance) {
+
+						minDistance = distance;
+						centerCentroid = j;
+
+					}
+
+				}
+
+				//A centroid closer than the center one anywhere in the cell is closer at one of its corners,
+				//the region where it wins is a half-space - the corners list every possible winner
+				//Centroids farther from the center than the center one plus the cell diagonal lose everywhere in the cell
+				float reach = std::sqrt(minDistance) + cellDiagonal + CANDIDATE_MARGIN;
+				float reachSquared = reach * reach;
+
+				cellCandidates.clear();
+				cellCandidates.push_back(centerCentroid);
+				for (uint32_t j = 0; j < centroids.count; ++j) {
+
+					if (j == centerCentroid || centerDistances[j] > reachSquared) continue;
+
+					for (uint32_t corner = 0; corner < 8; ++corner) {
+
+						float cornerR = (corner & 1) ? highR : lowR;
+						float cornerG = (corner & 2) ? highG : lowG;
+						float cornerB = (corner & 4) ? highB : lowB;
+
+						float centerDistance = SquaredDistance(centroids.r, centroids.g, centroids.b, centerCentroid, cornerR, cornerG, cornerB);
+						float distance = SquaredDistance(centroids.r, centroids.g, centroids.b, j, cornerR, cornerG, cornerB);
+						if (distance <= centerDistance + CANDIDATE_MARGIN) {
+
+							cellCandidates.push_back(j);
+							break;
+
+						}
+
+					}
+
+				}
+
+				size_t cellIndex = (static_cast<size_t>(cellR) << (2 * gridBits)) | (static_cast<size_t>(cellG) << gridBits) | cellB;
+				if (cellCandidates.size() == 1) {
+
+					m_cells[cellIndex] = centerCentroid;
+					continue;
+
+				}
+
+				//Searched in index order so ties go to the lower index like in the brute force search
+				std::sort(cellCandidates.begin(), cellCandidates.end());
+
+				m_cells[cellIndex] = BOUNDARY_CELL | static_cast<uint32_t>(m_candidates.size());
+				m_candidates.push_back(static_cast<uint32_t>(cellCandidates.size()));
+				m_candidates.insert(m_candidates.end(), cellCandidates.begin(), cellCandidates.end());
+				m_boundaryCellCount++;
+
+			}
+		}
+	}
+
+}
+
+bool PaletteLut::IsBuilt() const {
+
+	return !m_cells.empty();
+
+}
+
+void PaletteLut::Clear() {
+
+	m_cells.clear();
+	m_candidates.clear();
+	m_boundaryCellCount = 0;
+
+}
+
+void PaletteLut::Assign(const uint32_t* pixels, size_t pixelCount, uint32_t* assignments) const {
+
+	uint32_t shift = 8 - m_gridBits;
+
+	for (size_t i = 0; i < pixelCount; ++i) {
+
+		uint32_t colorR = (pixels[i] >> 16) & 0xFF;
+		uint32_t colorG = (pixels[i] >> 8) & 0xFF;
+		uint32_t colorB = pixels[i] & 0xFF;
+
+		uint32_t cell = m_cells[((colorR >> shift) << (2 * m_gridBits)) | ((colorG >> shift) << m_gridBits) | (colorB >> shift)];
+		if ((cell & BOUNDARY_CELL) == 0) {
+
+			assignments[i] = cell;
+			continue;
+
+		}
+
+		const uint32_t* candidates = m_candidates.data() + (cell & ~BOUNDARY_CELL);
+		uint32_t candidateCount = candidates[0];
+
+		float minDistance = 3.402823466e+38f;
+		uint32_t minDistanceIndex = 0;
+		for (uint32_t j = 1; j <= candidateCount; ++j) {
+
+			float distance = SquaredDistance(m_centroidR.data(), m_centroidG.data(), m_centroidB.data(), candidates[j],
+				static_cast<float>(colorR), static_cast<float>(colorG), static_cast<float>(colorB));
+			if (distance < minDistance) {
+
+				minDistance = distance;
+				minDistanceIndex = candidates[j];
+
+			}
+
+		}
+
+		assignments[i] = minDistanceIndex;
+
+	}
+
+}
+
+float PaletteLut::GetBoundaryCellRatio() const {
+
+	return m_cells.empty() ? 0.0f : static_cast<float>(m_boundaryCellCount) / static_cast<float>(m_cells.size());
+
+}
+
+}
@@ -0,0 +1,55 @@
+#include <palette_sizer.h>
+
+#include <cmath>
+
+namespace VoronoiCore {
+
+float PsnrToMeanSquaredError(float psnr) {
+
+	return 255.0f * 255.0f / std::pow(10.0f, psnr / 10.0f);
+
+}
+
+PaletteSizer::PaletteSizer(const PaletteSizeSettings& settings) :
+	m_settings(settings),
+	m_lastMeanSquaredError(-1.0f) {}
+
+PaletteSizer::~PaletteSizer() {}
+
+//The inertia of the last iteration is the squared error of the frame, summed over the three channels
+//k-means distortion in three dimensions falls roughly as k^(-2/3), which sizes the splits of a palette over the budget - at most
+//doubling it, as the estimate is rough and the merges take back what overshoots
+bool PaletteSizer::Update(KMeans& kmeans, const ColorHistogram& histogram) {
+
+	double inertia = kmeans.GetIterationStatistics().inertia;
+	double sampleCount = 3.0 * static_cast<double>(histogram.GetPixelCount());
+	if (inertia < 0.0 || sampleCount == 0.0) return false;
+
+	uint32_t centroidCount = kmeans.GetCentroidCount();
+	double targetInertia = static_cast<double>(m_settings.targetMeanSquaredError) * sampleCount;
+	m_lastMeanSquaredError = static_cast<float>(inertia / sampleCount);
+
+	if (inertia > targetInertia) {
+
+		if (centroidCount >= m_settings.maxCentroidCount) return false;
+
+		double neededCount = std::ceil(static_cast<double>(centroidCount) * std::pow(inertia / targetInertia, 1.5));
+		uint32_t splitCount = neededCount < 2.0 * centroidCount ? static_cast<uint32_t>(neededCount) - centroidCount : centroidCount;
+		if (splitCount < 1) splitCount = 1;
+		if (splitCount > m_settings.maxCentroidCount - centroidCount) splitCount = m_settings.maxCentroidCount - centroidCount;
+
+		return kmeans.SplitCentroids(histogram, splitCount) != 0;
+
+	}
+
+	return kmeans.MergeCentroids(histogram, targetInertia - inertia, m_settings.minCentroidCount) != 0;
+
+}
+
+float PaletteSizer::GetLastMeanSquaredError() const {
+
+	return m_lastMeanSquaredError;
+
+}
+
+}
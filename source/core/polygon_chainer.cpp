@@ -0,0 +1,91 @@
+#include <polygon_chainer.h>
+
+#include <algorithm>
+
+namespace VoronoiCore {
+
+namespace {
+
+const uint32_t NO_VERTEX = 0xFFFFFFFF;
+
+}
+
+PolygonChainer::PolygonChainer() {}
+
+PolygonChainer::~PolygonChainer() {}
+
+bool PolygonChainer::Chain(const EdgeIndex* edges, uint32_t edgeCount, std::vector<uint32_t>* loop) {
+
+	loop->clear();
+	if (edgeCount == 0) return false;
+
+	m_endpoints.clear();
+	for (uint32_t i = 0; i < edgeCount; ++i) {
+
+		m_endpoints.push_back((static_cast<uint64_t>(edges[i].a) << 32) | i);
+		m_endpoints.push_back((static_cast<uint64_t>(edges[i].b) << 32) | i);
+
+	}
+	std::sort(m_endpoints.begin(), m_endpoints.end());
+
+	m_isChained.assign(edgeCount, 0);
+	m_isChained[0] = 1;
+
+	uint32_t firstVertex = edges[0].a;
+	uint32_t vertex = edges[0].b;
+	loop->push_back(firstVertex);
+
+	for (uint32_t i = 1; i < edgeCount; ++i) {
+
+		//Closed before every edge was taken - more than one loop
+		if (vertex == firstVertex) return false;
+		loop->push_back(vertex);
+
+		//Next edge left at the vertex
+		uint32_t nextEdge = edgeCount;
+		std::vector<uint64_t>::const_iterator endpoint = std::lower_bound(m_endpoints.begin(), m_endpoints.end(), static_cast<uint64_t>(vertex) << 32);
+		for (; endpoint != m_endpoints.end() && static_cast<uint32_t>(*endpoint >> 32) == vertex; ++endpoint) {
+
+			uint32_t edge = static_cast<uint32_t>(*endpoint & 0xFFFFFFFF);
+			if (!m_isChained[edge]) {
+
+				nextEdge = edge;
+				break;
+
+			}
+
+		}
+
+		if (nextEdge == edgeCount) return false;
+
+		m_isChained[nextEdge] = 1;
+		vertex = edges[nextEdge].a == vertex ? edges[nextEdge].b : edges[nextEdge].a;
+
+	}
+
+	return vertex == firstVertex;
+
+}
+
+bool PolygonChainer::ChainDirected(const EdgeIndex* edges, uint32_t edgeCount, uint32_t vertexCount, std::vector<uint32_t>* loop) {
+
+	loop->clear();
+	if (edgeCount == 0) return false;
+
+	m_nextVertices.assign(vertexCount, NO_VERTEX);
+	for (uint32_t i = 0; i < edgeCount; ++i) m_nextVertices[edges[i].a] = edges[i].b;
+
+	uint32_t firstVertex = edges[0].a;
+	uint32_t vertex = firstVertex;
+	do {
+
+		loop->push_back(vertex);
+		vertex = m_nextVertices[vertex];
+
+	} while (vertex != firstVertex && vertex != NO_VERTEX && loop->size() < edgeCount);
+
+	return vertex == firstVertex && loop->size() == edgeCount;
+
+}
+
+}
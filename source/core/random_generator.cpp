@@ -0,0 +1,77 @@
+#include <random_generator.h>
+
+namespace VoronoiCore {
+
+namespace {
+
+const uint64_t PCG_MULTIPLIER = 6364136223846793005ull;
+
+//SplitMix64 finalizer
+uint64_t MixBits(uint64_t value) {
+
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+	return value ^ (value >> 31);
+
+}
+
+}
+
+RandomGenerator::RandomGenerator(uint64_t seed) : m_state(0), m_increment(0) {
+
+	SetSeed(seed);
+
+}
+
+RandomGenerator::~RandomGenerator() {}
+
+void RandomGenerator::SetSeed(uint64_t seed) {
+
+	m_state = 0;
+	m_increment = (MixBits(seed) << 1) | 1;
+	NextUInt32();
+	m_state += seed;
+	NextUInt32();
+
+}
+
+uint32_t RandomGenerator::NextUInt32() {
+
+	uint64_t state = m_state;
+	m_state = state * PCG_MULTIPLIER + m_increment;
+
+	uint32_t xorShifted = static_cast<uint32_t>(((state >> 18) ^ state) >> 27);
+	uint32_t rotation = static_cast<uint32_t>(state >> 59);
+
+	return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+
+}
+
+uint64_t RandomGenerator::NextUInt64() {
+
+	uint64_t high = NextUInt32();
+
+	return (high << 32) | NextUInt32();
+
+}
+
+float RandomGenerator::NextFloat() {
+
+	return static_cast<float>(NextUInt32() >> 8) * (1.0f / 16777216.0f);
+
+}
+
+double RandomGenerator::NextDouble() {
+
+	return static_cast<double>(NextUInt64() >> 11) * (1.0 / 9007199254740992.0);
+
+}
+
+double HashToUnitDouble(uint64_t seed, uint64_t index) {
+
+	return static_cast<double>(MixBits(seed + MixBits(index)) >> 11) * (1.0 / 9007199254740992.0);
+
+}
+
+}
@@ -0,0 +1,93 @@
+#include <scene_cut_detector.h>
+
+#include <cmath>
+
+namespace VoronoiCore {
+
+namespace {
+
+//Pixels binned from frames without a histogram
+const size_t MAX_SAMPLE_COUNT = 65536;
+
+}
+
+SceneCutDetector::SceneCutDetector(uint32_t binBits, float cutDistance) :
+	m_binBits(binBits),
+	m_cutDistance(cutDistance),
+	m_lastDistance(1.0f),
+	m_hasPreviousFrame(false),
+	m_binFractions(size_t(1) << (3 * binBits), 0.0f),
+	m_previousBinFractions(size_t(1) << (3 * binBits), 0.0f) {}
+
+SceneCutDetector::~SceneCutDetector() {}
+
+void SceneCutDetector::Reset() {
+
+	m_hasPreviousFrame = false;
+
+}
+
+bool SceneCutDetector::Update(const ColorHistogram& histogram) {
+
+	//The histogram entries already summarize the frame, binning them is cheap
+	const uint32_t* entryColors = histogram.GetEntryColors();
+	const uint32_t* entryCounts = histogram.GetEntryCounts();
+	float pixelScale = histogram.GetPixelCount() != 0 ? 1.0f / static_cast<float>(histogram.GetPixelCount()) : 0.0f;
+
+	m_binFractions.assign(m_binFractions.size(), 0.0f);
+	for (size_t i = 0; i < histogram.GetEntryCount(); ++i) m_binFractions[GetBin(entryColors[i])] += static_cast<float>(entryCounts[i]) * pixelScale;
+
+	return CompareWithPreviousFrame();
+
+}
+
+bool SceneCutDetector::Update(const uint32_t* pixels, size_t pixelCount) {
+
+	size_t stride = pixelCount > MAX_SAMPLE_COUNT ? pixelCount / MAX_SAMPLE_COUNT : 1;
+	size_t sampleCount = pixelCount / stride;
+	float sampleScale = sampleCount != 0 ? 1.0f / static_cast<float>(sampleCount) : 0.0f;
+
+	m_binFractions.assign(m_binFractions.size(), 0.0f);
+	for (size_t i = 0; i < sampleCount; ++i) m_binFractions[GetBin(pixels[i * stride])] += sampleScale;
+
+	return CompareWithPreviousFrame();
+
+}
+
+float SceneCutDetector::GetLastDistance() const {
+
+	return m_lastDistance;
+
+}
+
+uint32_t SceneCutDetector::GetBin(uint32_t color) const {
+
+	uint32_t shift = 8 - m_binBits;
+	uint32_t colorR = (color >> 16) & 0xFF;
+	uint32_t colorG = (color >> 8) & 0xFF;
+	uint32_t colorB = color & 0xFF;
+
+	return ((colorR >> shift) << (2 * m_binBits)) | ((colorG >> shift) << m_binBits) | (colorB >> shift);
+
+}
+
+//Distance of the binned frame to the previous one, which it then replaces
+bool SceneCutDetector::CompareWithPreviousFrame() {
+
+	m_lastDistance = 1.0f;
+	if (m_hasPreviousFrame) {
+
+		float distance = 0.0f;
+		for (size_t i = 0; i < m_binFractions.size(); ++i) distance += std::fabs(m_binFractions[i] - m_previousBinFractions[i]);
+		m_lastDistance = 0.5f * distance;
+
+	}
+
+	m_binFractions.swap(m_previousBinFractions);
+	m_hasPreviousFrame = true;
+
+	return m_lastDistance > m_cutDistance;
+
+}
+
+}
@@ -0,0 +1,217 @@
+#include <task_scheduler.h>
+
+namespace VoronoiCore {
+
+namespace {
+
+//Scheduler and queue index of the worker running on this thread
+thread_local const TaskScheduler* t_workerScheduler = nullptr;
+thread_local uint32_t t_workerIndex = 0;
+
+}
+
+TaskScheduler::TaskScheduler(uint32_t threadCount) : m_nextQueue(0), m_queuedTaskCount(0), m_isStopping(false) {
+
+	if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+	if (threadCount == 0) threadCount = 1;
+
+	for (uint32_t i = 0; i < threadCount; ++i) m_queues.push_back(std::make_unique<WorkerQueue>());
+	for (uint32_t i = 0; i < threadCount; ++i) m_workers.push_back(std::thread(&TaskScheduler::WorkerLoop, this, i));
+
+}
+
+//Queued tasks that never started are dropped, their futures report a broken promise
+TaskScheduler::~TaskScheduler() {
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_isStopping = true;
+	}
+	m_taskAvailable.notify_all();
+
+	for (size_t i = 0; i < m_workers.size(); ++i) m_workers[i].join();
+
+}
+
+uint32_t TaskScheduler::GetThreadCount() const {
+
+	return static_cast<uint32_t>(m_workers.size());
+
+}
+
+void TaskScheduler::ParallelFor(uint32_t taskCount, const std::function<void(uint32_t)>& task) {
+
+	if (taskCount == 0) return;
+
+	if (taskCount == 1) {
+
+		task(0);
+		return;
+
+	}
+
+	//Indices are claimed from a shared counter - runners that start after the last index is taken return at once
+	ParallelForState state;
+	state.task = &task;
+	state.taskCount = taskCount;
+	state.nextIndex.store(0);
+	state.doneCount.store(0);
+	state.finishedRunnerCount.store(0);
+
+	uint32_t runnerCount = taskCount - 1 < GetThreadCount() ? taskCount - 1 : GetThreadCount();
+	for (uint32_t i = 0; i < runnerCount; ++i) {
+
+		QueuedTask runner = { std::function<void()>(), &state };
+		Push(std::move(runner));
+
+	}
+
+	RunParallelFor(state);
+
+	//Help with other queued work instead of blocking while the last indices finish
+	//The state is on this stack, so the runners still queued are waited for too - they return at once when run
+	uint32_t queueIndex = t_workerScheduler == this ? t_workerIndex : 0;
+	while (state.doneCount.load(std::memory_order_acquire) != taskCount || state.finishedRunnerCount.load(std::memory_order_acquire) != runnerCount) {
+
+		if (!TryRunTask(queueIndex)) std::this_thread::yield();
+
+	}
+
+}
+
+void TaskScheduler::RunParallelFor(ParallelForState& state) {
+
+	while (true) {
+
+		uint32_t taskIndex = state.nextIndex.fetch_add(1);
+		if (taskIndex >= state.taskCount) return;
+
+		(*state.task)(taskIndex);
+		state.doneCount.fetch_add(1, std::memory_order_release);
+
+	}
+
+}
+
+void TaskScheduler::Push(QueuedTask task) {
+
+	uint32_t queueIndex = t_workerScheduler == this ? t_workerIndex : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % GetThreadCount();
+
+	{
+		std::lock_guard<std::mutex> lock(m_queues[queueIndex]->mutex);
+		m_queues[queueIndex]->PushBack(std::move(task));
+	}
+
+	//Counted under the sleep mutex so a worker about to sleep cannot miss it
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_queuedTaskCount.fetch_add(1);
+	}
+	m_taskAvailable.notify_one();
+
+}
+
+//Run the newest task of the own queue, otherwise steal the oldest task of another queue
+bool TaskScheduler::TryRunTask(uint32_t queueIndex) {
+
+	QueuedTask task = { std::function<void()>(), nullptr };
+	bool isTaskFound = false;
+	uint32_t queueCount = static_cast<uint32_t>(m_queues.size());
+
+	for (uint32_t i = 0; i < queueCount && !isTaskFound; ++i) {
+
+		WorkerQueue& queue = *m_queues[(queueIndex + i) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.IsEmpty()) continue;
+
+		task = i == 0 ? queue.PopBack() : queue.PopFront();
+		isTaskFound = true;
+
+	}
+
+	if (!isTaskFound) return false;
+
+	m_queuedTaskCount.fetch_sub(1);
+
+	if (task.parallelFor != nullptr) {
+
+		//The calling ParallelFor may return as soon as this is counted, the state must not be touched after it
+		RunParallelFor(*task.parallelFor);
+		task.parallelFor->finishedRunnerCount.fetch_add(1, std::memory_order_release);
+
+	}
+	else {
+
+		task.function();
+
+	}
+
+	return true;
+
+}
+
+void TaskScheduler::WorkerLoop(uint32_t threadIndex) {
+
+	t_workerScheduler = this;
+	t_workerIndex = threadIndex;
+
+	while (true) {
+
+		if (TryRunTask(threadIndex)) continue;
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_taskAvailable.wait(lock, [this] { return m_isStopping || m_queuedTaskCount.load() != 0; });
+		if (m_isStopping) return;
+
+	}
+
+}
+
+TaskScheduler::WorkerQueue::WorkerQueue() : tasks(64), first(0), count(0) {}
+
+bool TaskScheduler::WorkerQueue::IsEmpty() const {
+
+	return count == 0;
+
+}
+
+//A full buffer doubles with the queued tasks moved to its start, emptied slots drop their functions so captures are released
+void TaskScheduler::WorkerQueue::PushBack(QueuedTask task) {
+
+	if (count == tasks.size()) {
+
+		std::vector<QueuedTask> grownTasks(tasks.size() * 2);
+		for (size_t i = 0; i < count; ++i) grownTasks[i] = std::move(tasks[(first + i) % tasks.size()]);
+		tasks.swap(grownTasks);
+		first = 0;
+
+	}
+
+	tasks[(first + count) % tasks.size()] = std::move(task);
+	++count;
+
+}
+
+TaskScheduler::QueuedTask TaskScheduler::WorkerQueue::PopBack() {
+
+	--count;
+	QueuedTask& slot = tasks[(first + count) % tasks.size()];
+	QueuedTask task = std::move(slot);
+	slot.function = nullptr;
+
+	return task;
+
+}
+
+TaskScheduler::QueuedTask TaskScheduler::WorkerQueue::PopFront() {
+
+	QueuedTask task = std::move(tasks[first]);
+	tasks[first].function = nullptr;
+	first = (first + 1) % tasks.size();
+	--count;
+
+	return task;
+
+}
+
+}
@@ -0,0 +1,253 @@
+#include <voronoi_cell_builder.h>
+
+#include <utility>
+
+namespace VoronoiCore {
+
+namespace {
+
+const uint32_t NO_VERTEX = 0xFFFFFFFF;
+
+//Vertices closer to a plane are taken as on it and kept, a cut through a vertex does not add a copy of the vertex
+const float PLANE_DISTANCE_EPSILON = 0.000001f;
+
+}
+
+VoronoiCellBuilder::VoronoiCellBuilder() {}
+
+VoronoiCellBuilder::~VoronoiCellBuilder() {}
+
+//Start from the unit cube and clip it by the bisector plane of every neighbour
+void VoronoiCellBuilder::Build(const Point* sites, uint32_t site, const uint32_t* neighbors, uint32_t neighborCount, VoronoiCellList* cells) {
+
+	//Vertex i of the unit cube is (i & 1, (i >> 1) & 1, (i >> 2) & 1), faces in UNIT_CUBE_FACE_COUNT order
+	static const uint32_t unitCubeFaceVertices[24] = {
+		0, 2, 3, 1,
+		4, 5, 7, 6,
+		0, 1, 5, 4,
+		2, 6, 7, 3,
+		0, 4, 6, 2,
+		1, 3, 7, 5
+	};
+
+	m_cell.Clear();
+	for (uint32_t i = 0; i < 8; ++i) m_cell.vertices.emplace_back(static_cast<float>(i & 1), static_cast<float>((i >> 1) & 1), static_cast<float>((i >> 2) & 1));
+	m_cell.faceVertices.assign(unitCubeFaceVertices, unitCubeFaceVertices + 24);
+	for (uint32_t f = 0; f < UNIT_CUBE_FACE_COUNT; ++f) {
+
+		m_cell.faceOffsets.push_back(4 * f);
+		m_cell.faceNeighbors.push_back(-1 - static_cast<int32_t>(f));
+
+	}
+	m_cell.faceOffsets.push_back(24);
+
+	const Point& sitePoint = sites[site];
+	for (uint32_t i = 0; i < neighborCount; ++i) {
+
+		//Bisector plane - unit normal towards the neighbour, through the midpoint
+		const Point& neighborPoint = sites[neighbors[i]];
+		Point normal = Normalize(Subtract(neighborPoint, sitePoint));
+		if (Dot(normal, normal) == 0.0f) {
+
+			m_cell.Clear();
+			break;
+
+		}
+
+		Point midpoint((sitePoint.x + neighborPoint.x) * 0.5f, (sitePoint.y + neighborPoint.y) * 0.5f, (sitePoint.z + neighborPoint.z) * 0.5f);
+		if (!this->Clip(&m_cell, normal, Dot(normal, midpoint), static_cast<int32_t>(neighbors[i]))) break;
+
+	}
+
+	cells->Append(m_cell);
+
+}
+
+bool VoronoiCellBuilder::IsUnitCubeFace(int32_t faceNeighbor) {
+
+	return faceNeighbor < 0;
+
+}
+
+uint32_t VoronoiCellBuilder::GetUnitCubeFace(int32_t faceNeighbor) {
+
+	return static_cast<uint32_t>(-1 - faceNeighbor);
+
+}
+
+Point VoronoiCellBuilder::GetUnitCubeFaceNormal(uint32_t unitCubeFace) {
+
+	static const Point unitCubeFaceNormals[UNIT_CUBE_FACE_COUNT] = {
+		Point(0.0f, 0.0f, -1.0f), Point(0.0f, 0.0f, 1.0f),
+		Point(0.0f, -1.0f, 0.0f), Point(0.0f, 1.0f, 0.0f),
+		Point(-1.0f, 0.0f, 0.0f), Point(1.0f, 0.0f, 0.0f)
+	};
+
+	return unitCubeFaceNormals[unitCubeFace];
+
+}
+
+//Clip every face polygon against the plane, the new edges chain into the cut face
+//Vertices are classified once and the vertices on cut edges are shared, so both faces of an edge agree on the cut
+bool VoronoiCellBuilder::Clip(VoronoiCell* cell, const Point& normal, float offset, int32_t faceNeighbor) {
+
+	uint32_t vertexCount = static_cast<uint32_t>(cell->vertices.size());
+
+	//Signed distances, positive on the clipped side
+	bool isClipped = false;
+	bool isKept = false;
+	m_distances.resize(vertexCount);
+	for (uint32_t i = 0; i < vertexCount; ++i) {
+
+		m_distances[i] = Dot(normal, cell->vertices[i]) - offset;
+		if (m_distances[i] > PLANE_DISTANCE_EPSILON) isClipped = true;
+		if (m_distances[i] < -PLANE_DISTANCE_EPSILON) isKept = true;
+
+	}
+
+	if (!isClipped) return true;
+	if (!isKept) {
+
+		cell->Clear();
+		return false;
+
+	}
+
+	//Kept vertices first, the vertices on cut edges follow as the faces reach them
+	m_clippedCell.Clear();
+	m_vertexRemap.resize(vertexCount);
+	for (uint32_t i = 0; i < vertexCount; ++i) {
+
+		if (m_distances[i] > PLANE_DISTANCE_EPSILON) {
+
+			m_vertexRemap[i] = NO_VERTEX;
+
+		}
+		else {
+
+			m_vertexRemap[i] = static_cast<uint32_t>(m_clippedCell.vertices.size());
+			m_clippedCell.vertices.push_back(cell->vertices[i]);
+
+		}
+
+	}
+
+	m_edgeVertices.clear();
+	m_cutEdges.clear();
+
+	uint32_t faceCount = cell->GetFaceCount();
+	for (uint32_t f = 0; f < faceCount; ++f) {
+
+		uint32_t first = cell->faceOffsets[f];
+		uint32_t count = cell->faceOffsets[f + 1] - first;
+		uint32_t faceStart = static_cast<uint32_t>(m_clippedCell.faceVertices.size());
+		uint32_t entryVertex = NO_VERTEX;
+		uint32_t exitVertex = NO_VERTEX;
+
+		for (uint32_t k = 0; k < count; ++k) {
+
+			uint32_t vertex = cell->faceVertices[first + k];
+			uint32_t nextVertex = cell->faceVertices[first + (k + 1) % count];
+			bool isVertexClipped = m_distances[vertex] > PLANE_DISTANCE_EPSILON;
+			bool isNextVertexClipped = m_distances[nextVertex] > PLANE_DISTANCE_EPSILON;
+
+			if (!isVertexClipped) m_clippedCell.faceVertices.push_back(m_vertexRemap[vertex]);
+
+			//The face leaves the kept part - a vertex on the plane is the cut itself
+			if (!isVertexClipped && isNextVertexClipped) {
+
+				if (m_distances[vertex] >= -PLANE_DISTANCE_EPSILON) {
+
+					exitVertex = m_vertexRemap[vertex];
+
+				}
+				else {
+
+					exitVertex = this->GetEdgeVertex(*cell, vertex, nextVertex);
+					m_clippedCell.faceVertices.push_back(exitVertex);
+
+				}
+
+			}
+
+			//The face enters the kept part again
+			if (isVertexClipped && !isNextVertexClipped) {
+
+				if (m_distances[nextVertex] >= -PLANE_DISTANCE_EPSILON) {
+
+					entryVertex = m_vertexRemap[nextVertex];
+
+				}
+				else {
+
+					entryVertex = this->GetEdgeVertex(*cell, nextVertex, vertex);
+					m_clippedCell.faceVertices.push_back(entryVertex);
+
+				}
+
+			}
+
+		}
+
+		//The cut face runs along the new edge of the face the other way round
+		if (exitVertex != NO_VERTEX && entryVertex != exitVertex) {
+
+			m_cutEdges.emplace_back(entryVertex, exitVertex);
+
+		}
+
+		//Faces cut down to an edge or a vertex are dropped
+		if (m_clippedCell.faceVertices.size() - faceStart < 3) {
+
+			m_clippedCell.faceVertices.resize(faceStart);
+
+		}
+		else {
+
+			m_clippedCell.faceOffsets.push_back(faceStart);
+			m_clippedCell.faceNeighbors.push_back(cell->faceNeighbors[f]);
+
+		}
+
+	}
+
+	//Chain the cut edges into the new face, a loop broken by rounding leaves the cell open rather than adding a wrong face
+	uint32_t cutEdgeCount = static_cast<uint32_t>(m_cutEdges.size());
+	if (cutEdgeCount >= 3 && m_polygonChainer.ChainDirected(m_cutEdges.data(), cutEdgeCount, static_cast<uint32_t>(m_clippedCell.vertices.size()), &m_cutFace)) {
+
+		m_clippedCell.faceOffsets.push_back(static_cast<uint32_t>(m_clippedCell.faceVertices.size()));
+		m_clippedCell.faceVertices.insert(m_clippedCell.faceVertices.end(), m_cutFace.begin(), m_cutFace.end());
+		m_clippedCell.faceNeighbors.push_back(faceNeighbor);
+
+	}
+
+	m_clippedCell.faceOffsets.push_back(static_cast<uint32_t>(m_clippedCell.faceVertices.size()));
+	std::swap(*cell, m_clippedCell);
+
+	return true;
+
+}
+
+//Vertex where the plane crosses the edge from a kept to a clipped vertex, shared by the two faces of the edge
+uint32_t VoronoiCellBuilder::GetEdgeVertex(const VoronoiCell& cell, uint32_t keptVertex, uint32_t clippedVertex) {
+
+	uint64_t key = keptVertex < clippedVertex ? (static_cast<uint64_t>(keptVertex) << 32) | clippedVertex : (static_cast<uint64_t>(clippedVertex) << 32) | keptVertex;
+	for (uint32_t i = 0; i < m_edgeVertices.size(); ++i) {
+
+		if (m_edgeVertices[i].key == key) return m_edgeVertices[i].vertex;
+
+	}
+
+	const Point& a = cell.vertices[keptVertex];
+	const Point& b = cell.vertices[clippedVertex];
+	float t = m_distances[keptVertex] / (m_distances[keptVertex] - m_distances[clippedVertex]);
+
+	EdgeVertex edgeVertex = { key, static_cast<uint32_t>(m_clippedCell.vertices.size()) };
+	m_clippedCell.vertices.emplace_back(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t);
+	m_edgeVertices.push_back(edgeVertex);
+
+	return edgeVertex.vertex;
+
+}
+
+}
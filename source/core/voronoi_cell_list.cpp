@@ -0,0 +1,128 @@
+#include <voronoi_cell_list.h>
+
+#include <voronoi_cell_builder.h>
+
+namespace VoronoiCore {
+
+VoronoiCellList::VoronoiCellList() {
+
+	this->Clear();
+
+}
+
+VoronoiCellList::~VoronoiCellList() {}
+
+void VoronoiCellList::Clear() {
+
+	m_cellOffsets.clear();
+	m_vertices.clear();
+	m_faceOffsets.clear();
+	m_faceVertices.clear();
+	m_faceNeighbors.clear();
+
+	CellOffsets offsets = {};
+	m_cellOffsets.push_back(offsets);
+
+}
+
+void VoronoiCellList::Swap(VoronoiCellList& cells) {
+
+	m_cellOffsets.swap(cells.m_cellOffsets);
+	m_vertices.swap(cells.m_vertices);
+	m_faceOffsets.swap(cells.m_faceOffsets);
+	m_faceVertices.swap(cells.m_faceVertices);
+	m_faceNeighbors.swap(cells.m_faceNeighbors);
+
+}
+
+uint32_t VoronoiCellList::GetCellCount() const {
+
+	return static_cast<uint32_t>(m_cellOffsets.size() - 1);
+
+}
+
+VoronoiCellView VoronoiCellList::GetCell(uint32_t cell) const {
+
+	const CellOffsets& first = m_cellOffsets[cell];
+	const CellOffsets& last = m_cellOffsets[cell + 1];
+
+	VoronoiCellView view = {
+		m_vertices.data() + first.vertices,
+		m_faceOffsets.data() + first.faceOffsets,
+		m_faceVertices.data() + first.faceVertices,
+		m_faceNeighbors.data() + first.faceNeighbors,
+		last.vertices - first.vertices,
+		last.faceNeighbors - first.faceNeighbors
+	};
+
+	return view;
+
+}
+
+void VoronoiCellList::Append(const VoronoiCell& cell) {
+
+	m_vertices.insert(m_vertices.end(), cell.vertices.begin(), cell.vertices.end());
+	m_faceOffsets.insert(m_faceOffsets.end(), cell.faceOffsets.begin(), cell.faceOffsets.end());
+	m_faceVertices.insert(m_faceVertices.end(), cell.faceVertices.begin(), cell.faceVertices.end());
+	m_faceNeighbors.insert(m_faceNeighbors.end(), cell.faceNeighbors.begin(), cell.faceNeighbors.end());
+	this->AppendOffsets();
+
+}
+
+//A cell without faces has no face offsets either, like a cleared VoronoiCell
+void VoronoiCellList::Append(const VoronoiCellView& cell) {
+
+	uint32_t faceOffsetCount = cell.faceCount > 0 ? cell.faceCount + 1 : 0;
+	uint32_t faceVertexCount = cell.faceCount > 0 ? cell.faceOffsets[cell.faceCount] : 0;
+
+	m_vertices.insert(m_vertices.end(), cell.vertices, cell.vertices + cell.vertexCount);
+	m_faceOffsets.insert(m_faceOffsets.end(), cell.faceOffsets, cell.faceOffsets + faceOffsetCount);
+	m_faceVertices.insert(m_faceVertices.end(), cell.faceVertices, cell.faceVertices + faceVertexCount);
+	m_faceNeighbors.insert(m_faceNeighbors.end(), cell.faceNeighbors, cell.faceNeighbors + cell.faceCount);
+	this->AppendOffsets();
+
+}
+
+//The offsets of the appended cells move by the sizes of the lists so far
+void VoronoiCellList::Append(const VoronoiCellList& cells) {
+
+	CellOffsets base = m_cellOffsets.back();
+	for (uint32_t i = 1; i <= cells.GetCellCount(); ++i) {
+
+		const CellOffsets& offsets = cells.m_cellOffsets[i];
+		CellOffsets movedOffsets = {
+			base.vertices + offsets.vertices,
+			base.faceOffsets + offsets.faceOffsets,
+			base.faceVertices + offsets.faceVertices,
+			base.faceNeighbors + offsets.faceNeighbors
+		};
+		m_cellOffsets.push_back(movedOffsets);
+
+	}
+
+	m_vertices.insert(m_vertices.end(), cells.m_vertices.begin(), cells.m_vertices.end());
+	m_faceOffsets.insert(m_faceOffsets.end(), cells.m_faceOffsets.begin(), cells.m_faceOffsets.end());
+	m_faceVertices.insert(m_faceVertices.end(), cells.m_faceVertices.begin(), cells.m_faceVertices.end());
+	m_faceNeighbors.insert(m_faceNeighbors.end(), cells.m_faceNeighbors.begin(), cells.m_faceNeighbors.end());
+
+}
+
+void VoronoiCellList::AppendEmpty() {
+
+	this->AppendOffsets();
+
+}
+
+void VoronoiCellList::AppendOffsets() {
+
+	CellOffsets offsets = {
+		static_cast<uint32_t>(m_vertices.size()),
+		static_cast<uint32_t>(m_faceOffsets.size()),
+		static_cast<uint32_t>(m_faceVertices.size()),
+		static_cast<uint32_t>(m_faceNeighbors.size())
+	};
+	m_cellOffsets.push_back(offsets);
+
+}
+
+}
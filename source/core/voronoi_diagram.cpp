@@ -0,0 +1,734 @@
+#include <voronoi_diagram.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace VoronoiCore {
+
+namespace {
+
+//Bands per scheduler thread - cells near the unit cube corners clip faster than the inner ones, more bands even that out
+const uint32_t CELL_BANDS_PER_THREAD = 4;
+
+//Moving the centroids one by one costs more than triangulating them again once more than a quarter of them moved
+const uint32_t MOVED_CENTROID_DIVISOR = 4;
+
+Point RandomColor() {
+
+	float colorR = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+	float colorG = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+	float colorB = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+
+	return Point(colorR, colorG, colorB);
+
+}
+
+}
+
+VoronoiDiagram::VoronoiDiagram(TaskScheduler* taskScheduler) : m_taskScheduler(taskScheduler) {
+
+	m_delaunayTriangulation = std::make_unique<DelaunayTriangulation>();
+	m_polygonChainer = std::make_unique<PolygonChainer>();
+
+	uint32_t maxBandCount = m_taskScheduler != nullptr ? m_taskScheduler->GetThreadCount() * CELL_BANDS_PER_THREAD : 1;
+	for (uint32_t i = 0; i < maxBandCount; ++i) m_cellBuilders.push_back(std::make_unique<VoronoiCellBuilder>());
+	m_bandCells.resize(maxBandCount);
+
+}
+
+VoronoiDiagram::~VoronoiDiagram() {}
+
+//Triangulate the centroids and construct the voronoi cells clipped to the unit cube
+void VoronoiDiagram::Build(const Point* centroids, uint32_t centroidCount) {
+
+	m_centroids.assign(centroids, centroids + centroidCount);
+	m_isCentroidMoved.assign(centroidCount, 1);
+
+	m_previousDelaunayEdgeKeys.clear();
+	m_previousDelaunayEdgeColors.clear();
+	m_previousCentroidNeighborOffsets.clear();
+	m_previousCentroidNeighbors.clear();
+	m_previousCellMeshOffsets.clear();
+	m_unitCubeFaceColors.clear();
+
+	this->Clear();
+	m_delaunayTriangulation->Build(m_centroids.data(), centroidCount);
+	this->ConstructDelaunayEdges();
+	this->ConstructVoronoiFaces();
+	this->ConstructCells();
+	this->ConstructCellTriangles();
+
+}
+
+//Late k-means iterations move few centroids by little, the triangulation changes around them only and most cells keep their neighbours
+void VoronoiDiagram::Update(const Point* centroids, uint32_t centroidCount) {
+
+	if (centroidCount == 0 || centroidCount != m_centroids.size() || m_voronoiCells.GetCellCount() != centroidCount || m_delaunayTriangulation->GetInsertedCount() != centroidCount) {
+
+		this->Build(centroids, centroidCount);
+		return;
+
+	}
+
+	uint32_t movedCount = 0;
+	m_isCentroidMoved.assign(centroidCount, 0);
+	for (uint32_t i = 0; i < centroidCount; ++i) {
+
+		if (centroids[i].x != m_centroids[i].x || centroids[i].y != m_centroids[i].y || centroids[i].z != m_centroids[i].z) {
+
+			m_isCentroidMoved[i] = 1;
+			++movedCount;
+
+		}
+
+	}
+
+	if (movedCount == 0) return;
+
+	m_centroids.assign(centroids, centroids + centroidCount);
+
+	//A move that cannot fill the hole it leaves triangulates everything again
+	bool isTriangulationKept = movedCount <= centroidCount / MOVED_CENTROID_DIVISOR;
+	for (uint32_t i = 0; i < centroidCount && isTriangulationKept; ++i) {
+
+		if (m_isCentroidMoved[i] != 0) isTriangulationKept = m_delaunayTriangulation->MovePoint(i, m_centroids[i]);
+
+	}
+	if (!isTriangulationKept) m_delaunayTriangulation->Build(m_centroids.data(), centroidCount);
+
+	//Edge colors, neighbours and mesh offsets of the previous diagram tell the unchanged faces and cells apart
+	m_previousDelaunayEdgeKeys.swap(m_delaunayEdgeKeys);
+	m_previousDelaunayEdgeColors.swap(m_delaunayEdgeColors);
+	m_previousCentroidNeighborOffsets.swap(m_centroidNeighborOffsets);
+	m_previousCentroidNeighbors.swap(m_centroidNeighbors);
+	m_previousCellMeshOffsets.swap(m_cellMeshOffsets);
+	m_previousVoronoiCells.Swap(m_voronoiCells);
+
+	this->Clear();
+	this->ConstructDelaunayEdges();
+	this->ConstructVoronoiFaces();
+	this->ConstructCells();
+	this->ConstructCellTriangles();
+
+}
+
+const std::vector<Tetrahedron>& VoronoiDiagram::GetTriangulation() const { return m_triangulation; }
+const std::vector<Tetrahedron>& VoronoiDiagram::GetCentroidTetrahedrons() const { return m_centroidTetrahedrons; }
+const std::vector<Edge>& VoronoiDiagram::GetDelaunayEdges() const { return m_delaunayEdges; }
+const std::vector<VoronoiEdge>& VoronoiDiagram::GetVoronoiEdges() const { return m_voronoiEdges; }
+const std::vector<ColorEdge>& VoronoiDiagram::GetVoronoiColoredEdges() const { return m_voronoiColoredEdges; }
+const std::vector<ColorTriangle>& VoronoiDiagram::GetVoronoiColoredTriangles() const { return m_voronoiColoredTriangles; }
+const std::vector<Edge>& VoronoiDiagram::GetVoronoiFaces() const { return m_voronoiFaces; }
+const std::vector<uint32_t>& VoronoiDiagram::GetVoronoiFacesCount() const { return m_voronoiFacesCount; }
+const std::vector<ColorTriangle>& VoronoiDiagram::GetClippedVoronoiTriangles() const { return m_clippedVoronoiTriangles; }
+const std::vector<ColorTriangle>& VoronoiDiagram::GetClippedVoronoiCellsTriangles() const { return m_clippedVoronoiCellsTriangles; }
+const std::vector<NormalColorTriangle>& VoronoiDiagram::GetClippedVoronoiTrianglesFaceNormals() const { return m_clippedVoronoiTrianglesFaceNormals; }
+const std::vector<ColorEdge>& VoronoiDiagram::GetVoronoiEdgesUnitCube() const { return m_voronoiEdgesUnitCube; }
+const std::vector<ColorTriangle>& VoronoiDiagram::GetClippedVoronoiCellsBackCulledTriangles() const { return m_clippedVoronoiCellsBackCulledTriangles; }
+const std::vector<NormalColorTriangle>& VoronoiDiagram::GetClippedVoronoiCellsBackCulledTrianglesNormals() const { return m_clippedVoronoiCellsBackCulledTrianglesNormals; }
+const std::vector<Edge>& VoronoiDiagram::GetUnitCubeEdges() const { return m_unitCubeEdges; }
+const VoronoiCellList& VoronoiDiagram::GetVoronoiCells() const { return m_voronoiCells; }
+
+//Clear vectors, the render lists of the cell meshes keep their contents and are overwritten where they changed
+void VoronoiDiagram::Clear() {
+
+	m_triangulation.clear();
+	m_circumcenters.clear();
+	m_delaunayEdgeKeys.clear();
+	m_delaunayEdges.clear();
+	m_delaunayEdgesIndex.clear();
+	m_delaunayEdgeOffsets.clear();
+	m_delaunayEdgeColors.clear();
+	m_centroidTetrahedrons.clear();
+
+	m_voronoiEdges.clear();
+	m_voronoiEdgesIndex.clear();
+	m_voronoiFaceEdgePairs.clear();
+	m_voronoiFaceOffsets.clear();
+	m_voronoiFace.clear();
+	m_voronoiFaceLoop.clear();
+	m_voronoiColoredEdges.clear();
+	m_voronoiColoredTriangles.clear();
+	m_voronoiFaces.clear();
+	m_voronoiFacesCount.clear();
+
+	m_centroidNeighborOffsets.clear();
+	m_centroidNeighbors.clear();
+	m_centroidNeighborCursors.clear();
+	m_cellMeshOffsets.clear();
+
+	m_unitCubeEdges.clear();
+
+}
+
+//Circumspheres of the tetrahedrons of the delaunay triangulation, then the delaunay edges between centroids
+//Edges and centroid tetrahedrons come straight from the vertex indices of the tetrahedrons
+void VoronoiDiagram::ConstructDelaunayEdges() {
+
+	const std::vector<Point>& vertices = m_delaunayTriangulation->GetVertices();
+	const std::vector<DelaunayTetrahedron>& tetrahedrons = m_delaunayTriangulation->GetTetrahedrons();
+
+	//Circumcenters are indexed by tetrahedron slot
+	m_circumcenters.resize(tetrahedrons.size());
+
+	for (int32_t i = 0; i < static_cast<int32_t>(tetrahedrons.size()); ++i) {
+
+		if (m_delaunayTriangulation->IsFree(i)) continue;
+
+		const int32_t* tetrahedronVertices = tetrahedrons[i].vertices;
+
+		Tetrahedron tetrahedron = {};
+		tetrahedron.a = vertices[tetrahedronVertices[0]];
+		tetrahedron.b = vertices[tetrahedronVertices[1]];
+		tetrahedron.c = vertices[tetrahedronVertices[2]];
+		tetrahedron.d = vertices[tetrahedronVertices[3]];
+		CalculateCircumsphere(&tetrahedron);
+		m_triangulation.push_back(tetrahedron);
+		m_circumcenters[i] = tetrahedron.circumcenter;
+
+		//Delaunay edges - only connected centroids
+		bool isCentroidTetrahedron = true;
+		for (uint32_t j = 0; j < 4; ++j) {
+
+			if (m_delaunayTriangulation->IsSuperVertex(tetrahedronVertices[j])) {
+
+				isCentroidTetrahedron = false;
+				continue;
+
+			}
+
+			for (uint32_t k = j + 1; k < 4; ++k) {
+
+				if (m_delaunayTriangulation->IsSuperVertex(tetrahedronVertices[k])) continue;
+
+				uint32_t indexA = static_cast<uint32_t>(tetrahedronVertices[j] < tetrahedronVertices[k] ? tetrahedronVertices[j] : tetrahedronVertices[k]);
+				uint32_t indexB = static_cast<uint32_t>(tetrahedronVertices[j] < tetrahedronVertices[k] ? tetrahedronVertices[k] : tetrahedronVertices[j]);
+				m_delaunayEdgeKeys.push_back((static_cast<uint64_t>(indexA) << 32) | indexB);
+
+			}
+
+		}
+
+		//Tetrahedrons spanned only by centroids
+		if (isCentroidTetrahedron) m_centroidTetrahedrons.push_back(tetrahedron);
+
+	}
+
+	//Every edge is shared by several tetrahedrons, sorted keys list the edges by their first then second centroid
+	std::sort(m_delaunayEdgeKeys.begin(), m_delaunayEdgeKeys.end());
+	m_delaunayEdgeKeys.erase(std::unique(m_delaunayEdgeKeys.begin(), m_delaunayEdgeKeys.end()), m_delaunayEdgeKeys.end());
+
+	m_delaunayEdgeOffsets.assign(m_centroids.size() + 1, 0);
+	for (size_t i = 0; i < m_delaunayEdgeKeys.size(); ++i) {
+
+		uint32_t indexA = static_cast<uint32_t>(m_delaunayEdgeKeys[i] >> 32);
+		uint32_t indexB = static_cast<uint32_t>(m_delaunayEdgeKeys[i] & 0xFFFFFFFF);
+		m_delaunayEdges.emplace_back(m_centroids[indexA], m_centroids[indexB]);
+		m_delaunayEdgesIndex.emplace_back(indexA, indexB);
+		m_delaunayEdgeOffsets[indexA + 1]++;
+
+	}
+
+	for (size_t i = 1; i < m_delaunayEdgeOffsets.size(); ++i) m_delaunayEdgeOffsets[i] += m_delaunayEdgeOffsets[i - 1];
+
+}
+
+//Voronoi edges connect the circumcenters of neighbouring tetrahedrons, the edges around a delaunay edge form its voronoi face
+void VoronoiDiagram::ConstructVoronoiFaces() {
+
+	const std::vector<DelaunayTetrahedron>& tetrahedrons = m_delaunayTriangulation->GetTetrahedrons();
+	uint32_t delaunayEdgeCount = static_cast<uint32_t>(m_delaunayEdgesIndex.size());
+
+	//One voronoi edge per shared face, it borders the voronoi faces of the three delaunay edges of the shared face
+	for (int32_t i = 0; i < static_cast<int32_t>(tetrahedrons.size()); ++i) {
+
+		if (m_delaunayTriangulation->IsFree(i)) continue;
+
+		for (uint32_t f = 0; f < 4; ++f) {
+
+			int32_t neighbor = tetrahedrons[i].neighbors[f];
+			if (neighbor == DelaunayTriangulation::NO_TETRAHEDRON || neighbor < i) continue;
+
+			uint32_t voronoiEdgeIndex = static_cast<uint32_t>(m_voronoiEdges.size());
+			m_voronoiEdges.emplace_back(m_circumcenters[i], m_circumcenters[neighbor]);
+			m_voronoiEdgesIndex.emplace_back(static_cast<uint32_t>(i), static_cast<uint32_t>(neighbor));
+
+			for (uint32_t j = 1; j < 4; ++j) {
+
+				for (uint32_t k = j + 1; k < 4; ++k) {
+
+					int32_t vertexA = tetrahedrons[i].vertices[(f + j) % 4];
+					int32_t vertexB = tetrahedrons[i].vertices[(f + k) % 4];
+					if (m_delaunayTriangulation->IsSuperVertex(vertexA) || m_delaunayTriangulation->IsSuperVertex(vertexB)) continue;
+
+					uint32_t delaunayEdge = this->FindDelaunayEdge(static_cast<uint32_t>(vertexA), static_cast<uint32_t>(vertexB));
+					if (delaunayEdge < delaunayEdgeCount) m_voronoiFaceEdgePairs.emplace_back(delaunayEdge, voronoiEdgeIndex);
+
+				}
+
+			}
+
+		}
+
+	}
+
+	std::sort(m_voronoiFaceEdgePairs.begin(), m_voronoiFaceEdgePairs.end(), [](const EdgeIndex& a, const EdgeIndex& b) { return a.a < b.a || (a.a == b.a && a.b < b.b); });
+
+	m_voronoiFaceOffsets.assign(delaunayEdgeCount + 1, 0);
+	for (size_t i = 0; i < m_voronoiFaceEdgePairs.size(); ++i) m_voronoiFaceOffsets[m_voronoiFaceEdgePairs[i].a + 1]++;
+	for (size_t i = 1; i < m_voronoiFaceOffsets.size(); ++i) m_voronoiFaceOffsets[i] += m_voronoiFaceOffsets[i - 1];
+
+	const float scaleConstant = 1.0f;
+
+	//Voronoi polygonal face of every delaunay edge - an edge of the previous diagram keeps its color, both key lists are sorted
+	size_t previousEdge = 0;
+	for (uint32_t i = 0; i < delaunayEdgeCount; ++i) {
+
+		uint64_t key = m_delaunayEdgeKeys[i];
+		while (previousEdge < m_previousDelaunayEdgeKeys.size() && m_previousDelaunayEdgeKeys[previousEdge] < key) ++previousEdge;
+
+		bool isPreviousEdge = previousEdge < m_previousDelaunayEdgeKeys.size() && m_previousDelaunayEdgeKeys[previousEdge] == key;
+		Point color = isPreviousEdge ? m_previousDelaunayEdgeColors[previousEdge] : RandomColor();
+		m_delaunayEdgeColors.push_back(color);
+
+		m_voronoiFace.clear();
+		for (uint32_t j = m_voronoiFaceOffsets[i]; j < m_voronoiFaceOffsets[i + 1]; ++j) m_voronoiFace.push_back(m_voronoiEdgesIndex[m_voronoiFaceEdgePairs[j].b]);
+
+		for (uint32_t j = 0; j < m_voronoiFace.size(); ++j) {
+
+			const Point& a = m_circumcenters[m_voronoiFace[j].a];
+			const Point& b = m_circumcenters[m_voronoiFace[j].b];
+			m_voronoiColoredEdges.emplace_back(a, b, color);
+			m_voronoiFaces.emplace_back(a, b);
+
+		}
+		m_voronoiFacesCount.push_back(static_cast<uint32_t>(m_voronoiFace.size()));
+
+		if (m_voronoiFace.size() > 2) {
+
+			//Loop of circumcenters around the delaunay edge
+			m_polygonChainer->Chain(m_voronoiFace.data(), static_cast<uint32_t>(m_voronoiFace.size()), &m_voronoiFaceLoop);
+
+			//Triangle fan around both delaunay edge endpoints
+			const Point* edgePoints[2] = { &m_delaunayEdges[i].a, &m_delaunayEdges[i].b };
+			for (uint32_t j = 2; j < m_voronoiFaceLoop.size(); ++j) {
+
+				for (uint32_t e = 0; e < 2; ++e) {
+
+					Point centeredPointA = m_circumcenters[m_voronoiFaceLoop[0]];
+					Point centeredPointB = m_circumcenters[m_voronoiFaceLoop[j - 1]];
+					Point centeredPointC = m_circumcenters[m_voronoiFaceLoop[j]];
+
+					centeredPointA -= *edgePoints[e];
+					centeredPointB -= *edgePoints[e];
+					centeredPointC -= *edgePoints[e];
+
+					centeredPointA *= scaleConstant;
+					centeredPointB *= scaleConstant;
+					centeredPointC *= scaleConstant;
+
+					centeredPointA += *edgePoints[e];
+					centeredPointB += *edgePoints[e];
+					centeredPointC += *edgePoints[e];
+
+					m_voronoiColoredTriangles.emplace_back(centeredPointA, centeredPointB, centeredPointC, color);
+
+				}
+
+			}
+
+		}
+
+	}
+
+}
+
+//Every cell starts as the unit cube and is clipped by the bisector planes of its delaunay neighbours
+void VoronoiDiagram::ConstructCells() {
+
+	uint32_t centroidCount = static_cast<uint32_t>(m_centroids.size());
+
+	//Neighbours of every centroid from both ends of the delaunay edges
+	m_centroidNeighborOffsets.assign(centroidCount + 1, 0);
+	for (uint32_t i = 0; i < m_delaunayEdgesIndex.size(); ++i) {
+
+		m_centroidNeighborOffsets[m_delaunayEdgesIndex[i].a + 1]++;
+		m_centroidNeighborOffsets[m_delaunayEdgesIndex[i].b + 1]++;
+
+	}
+	for (uint32_t i = 1; i <= centroidCount; ++i) m_centroidNeighborOffsets[i] += m_centroidNeighborOffsets[i - 1];
+
+	m_centroidNeighbors.resize(m_centroidNeighborOffsets[centroidCount]);
+	m_centroidNeighborCursors.assign(m_centroidNeighborOffsets.begin(), m_centroidNeighborOffsets.end() - 1);
+	for (uint32_t i = 0; i < m_delaunayEdgesIndex.size(); ++i) {
+
+		m_centroidNeighbors[m_centroidNeighborCursors[m_delaunayEdgesIndex[i].a]++] = m_delaunayEdgesIndex[i].b;
+		m_centroidNeighbors[m_centroidNeighborCursors[m_delaunayEdgesIndex[i].b]++] = m_delaunayEdgesIndex[i].a;
+
+	}
+
+	//Colors of the faces on the unit cube, drawn up front so they do not depend on the order the cells are built in, an update keeps them
+	for (size_t i = m_unitCubeFaceColors.size(); i < centroidCount * VoronoiCellBuilder::UNIT_CUBE_FACE_COUNT; ++i) m_unitCubeFaceColors.push_back(RandomColor());
+
+	m_isCellChanged.resize(centroidCount);
+	for (uint32_t i = 0; i < centroidCount; ++i) m_isCellChanged[i] = this->IsCellChanged(i) ? 1 : 0;
+
+	//Clip the cells and measure their meshes band by band, then gather the band lists
+	//The bands capture no more than fits in the task function itself, so running them does not allocate
+	uint32_t bandSize = 0;
+	uint32_t bandCount = this->SplitCellBands(&bandSize);
+
+	m_cellMeshOffsets.assign(centroidCount + 1, CellMeshOffsets());
+	this->RunCellBands(bandCount, [this, bandSize](uint32_t bandIndex) {
+
+		uint32_t cellCount = static_cast<uint32_t>(m_centroids.size());
+		VoronoiCellBuilder* cellBuilder = m_cellBuilders[bandIndex].get();
+		VoronoiCellList& bandCells = m_bandCells[bandIndex];
+		uint32_t bandStart = bandIndex * bandSize;
+		uint32_t bandEnd = bandStart + bandSize < cellCount ? bandStart + bandSize : cellCount;
+
+		bandCells.Clear();
+		for (uint32_t i = bandStart; i < bandEnd; ++i) {
+
+			//Unchanged cells are copied from the previous cells, duplicates were left out of the triangulation and the cell of the first copy covers them
+			if (m_isCellChanged[i] == 0) {
+
+				bandCells.Append(m_previousVoronoiCells.GetCell(i));
+
+			}
+			else if (m_delaunayTriangulation->IsInserted(i)) {
+
+				uint32_t neighborOffset = m_centroidNeighborOffsets[i];
+				cellBuilder->Build(m_centroids.data(), i, m_centroidNeighbors.data() + neighborOffset, m_centroidNeighborOffsets[i + 1] - neighborOffset, &bandCells);
+
+			}
+			else {
+
+				bandCells.AppendEmpty();
+
+			}
+
+			this->MeasureCellMesh(i, bandCells.GetCell(i - bandStart));
+
+		}
+
+	});
+
+	m_voronoiCells.Clear();
+	for (uint32_t i = 0; i < bandCount; ++i) m_voronoiCells.Append(m_bandCells[i]);
+
+	//Offsets of every cell in the render lists, the last entry holds the list sizes
+	for (uint32_t i = 1; i <= centroidCount; ++i) {
+
+		CellMeshOffsets& offsets = m_cellMeshOffsets[i];
+		const CellMeshOffsets& previousOffsets = m_cellMeshOffsets[i - 1];
+
+		offsets.cellTriangles += previousOffsets.cellTriangles;
+		offsets.sharedTriangles += previousOffsets.sharedTriangles;
+		offsets.sharedEdges += previousOffsets.sharedEdges;
+		offsets.unitCubeTriangles += previousOffsets.unitCubeTriangles;
+		offsets.unitCubeEdges += previousOffsets.unitCubeEdges;
+		offsets.interiorTriangles += previousOffsets.interiorTriangles;
+
+	}
+
+}
+
+//Construct the render triangle lists of the clipped cells, every band writes the meshes of its cells
+//Faces between cells come before the faces on the unit cube in the face normal, edge and back culled lists
+void VoronoiDiagram::ConstructCellTriangles() {
+
+	uint32_t centroidCount = static_cast<uint32_t>(m_centroids.size());
+	const CellMeshOffsets& listSizes = m_cellMeshOffsets[centroidCount];
+
+	m_clippedVoronoiCellsTriangles.resize(listSizes.cellTriangles);
+	m_clippedVoronoiTriangles.resize(listSizes.sharedTriangles);
+	m_clippedVoronoiTrianglesFaceNormals.resize(listSizes.sharedTriangles + listSizes.unitCubeTriangles);
+	m_voronoiEdgesUnitCube.resize(listSizes.sharedEdges + listSizes.unitCubeEdges);
+	m_clippedVoronoiCellsBackCulledTriangles.resize(listSizes.interiorTriangles + listSizes.unitCubeTriangles);
+	m_clippedVoronoiCellsBackCulledTrianglesNormals.resize(listSizes.interiorTriangles + listSizes.unitCubeTriangles);
+
+	uint32_t bandSize = 0;
+	uint32_t bandCount = this->SplitCellBands(&bandSize);
+
+	this->RunCellBands(bandCount, [this, bandSize](uint32_t bandIndex) {
+
+		uint32_t cellCount = static_cast<uint32_t>(m_centroids.size());
+		uint32_t bandEnd = (bandIndex + 1) * bandSize < cellCount ? (bandIndex + 1) * bandSize : cellCount;
+		for (uint32_t i = bandIndex * bandSize; i < bandEnd; ++i) {
+
+			if (m_isCellChanged[i] != 0 || !this->IsCellMeshKept(i)) this->ConstructCellMesh(i);
+
+		}
+
+	});
+
+	//Construct unit cube edges
+	m_unitCubeEdges.emplace_back(Point(0.0f, 0.0f, 0.0f), Point(0.0f, 1.0f, 0.0f));
+	m_unitCubeEdges.emplace_back(Point(0.0f, 0.0f, 0.0f), Point(1.0f, 0.0f, 0.0f));
+	m_unitCubeEdges.emplace_back(Point(1.0f, 1.0f, 0.0f), Point(0.0f, 1.0f, 0.0f));
+	m_unitCubeEdges.emplace_back(Point(1.0f, 1.0f, 0.0f), Point(1.0f, 0.0f, 0.0f));
+	m_unitCubeEdges.emplace_back(Point(0.0f, 0.0f, 1.0f), Point(0.0f, 1.0f, 1.0f));
+	m_unitCubeEdges.emplace_back(Point(0.0f, 0.0f, 1.0f), Point(1.0f, 0.0f, 1.0f));
+	m_unitCubeEdges.emplace_back(Point(1.0f, 1.0f, 1.0f), Point(0.0f, 1.0f, 1.0f));
+	m_unitCubeEdges.emplace_back(Point(1.0f, 1.0f, 1.0f), Point(1.0f, 0.0f, 1.0f));
+	m_unitCubeEdges.emplace_back(Point(0.0f, 0.0f, 0.0f), Point(0.0f, 0.0f, 1.0f));
+	m_unitCubeEdges.emplace_back(Point(0.0f, 1.0f, 0.0f), Point(0.0f, 1.0f, 1.0f));
+	m_unitCubeEdges.emplace_back(Point(1.0f, 1.0f, 0.0f), Point(1.0f, 1.0f, 1.0f));
+	m_unitCubeEdges.emplace_back(Point(1.0f, 0.0f, 0.0f), Point(1.0f, 0.0f, 1.0f));
+
+}
+
+uint32_t VoronoiDiagram::SplitCellBands(uint32_t* bandSize) const {
+
+	uint32_t centroidCount = static_cast<uint32_t>(m_centroids.size());
+	uint32_t bandCount = static_cast<uint32_t>(m_cellBuilders.size());
+	if (bandCount > centroidCount) bandCount = centroidCount;
+	if (bandCount == 0) {
+
+		*bandSize = 0;
+		return 0;
+
+	}
+
+	*bandSize = (centroidCount + bandCount - 1) / bandCount;
+
+	return (centroidCount + *bandSize - 1) / *bandSize;
+
+}
+
+void VoronoiDiagram::RunCellBands(uint32_t bandCount, const std::function<void(uint32_t)>& band) const {
+
+	if (m_taskScheduler != nullptr) {
+
+		m_taskScheduler->ParallelFor(bandCount, band);
+
+	}
+	else {
+
+		for (uint32_t i = 0; i < bandCount; ++i) band(i);
+
+	}
+
+}
+
+//A cell is clipped again when its centroid or one of its neighbours moved or its neighbours are not the previous ones
+bool VoronoiDiagram::IsCellChanged(uint32_t centroidIndex) const {
+
+	if (m_isCentroidMoved[centroidIndex] != 0 || m_previousCentroidNeighborOffsets.size() != m_centroidNeighborOffsets.size()) return true;
+
+	uint32_t first = m_centroidNeighborOffsets[centroidIndex];
+	uint32_t count = m_centroidNeighborOffsets[centroidIndex + 1] - first;
+	uint32_t previousFirst = m_previousCentroidNeighborOffsets[centroidIndex];
+	if (m_previousCentroidNeighborOffsets[centroidIndex + 1] - previousFirst != count) return true;
+
+	for (uint32_t i = 0; i < count; ++i) {
+
+		uint32_t neighbor = m_centroidNeighbors[first + i];
+		if (neighbor != m_previousCentroidNeighbors[previousFirst + i] || m_isCentroidMoved[neighbor] != 0) return true;
+
+	}
+
+	return false;
+
+}
+
+//The mesh of an unchanged cell is still in the render lists when neither its offsets nor the list sizes moved
+bool VoronoiDiagram::IsCellMeshKept(uint32_t centroidIndex) const {
+
+	if (m_previousCellMeshOffsets.size() != m_cellMeshOffsets.size()) return false;
+
+	auto isSameOffsets = [](const CellMeshOffsets& a, const CellMeshOffsets& b) {
+
+		return a.cellTriangles == b.cellTriangles && a.sharedTriangles == b.sharedTriangles && a.sharedEdges == b.sharedEdges &&
+			a.unitCubeTriangles == b.unitCubeTriangles && a.unitCubeEdges == b.unitCubeEdges && a.interiorTriangles == b.interiorTriangles;
+
+	};
+
+	return isSameOffsets(m_cellMeshOffsets[centroidIndex], m_previousCellMeshOffsets[centroidIndex]) && isSameOffsets(m_cellMeshOffsets.back(), m_previousCellMeshOffsets.back());
+
+}
+
+//Triangles and edges the cell adds to every render list
+void VoronoiDiagram::MeasureCellMesh(uint32_t centroidIndex, const VoronoiCellView& cell) {
+
+	CellMeshOffsets counts = {};
+
+	for (uint32_t f = 0; f < cell.GetFaceCount(); ++f) {
+
+		int32_t faceNeighbor = cell.faceNeighbors[f];
+		uint32_t edgeCount = cell.faceOffsets[f + 1] - cell.faceOffsets[f];
+		uint32_t triangleCount = edgeCount - 2;
+
+		counts.cellTriangles += triangleCount;
+		if (VoronoiCellBuilder::IsUnitCubeFace(faceNeighbor)) {
+
+			counts.unitCubeTriangles += triangleCount;
+			counts.unitCubeEdges += edgeCount;
+
+		}
+		else {
+
+			counts.interiorTriangles += triangleCount;
+			if (faceNeighbor > static_cast<int32_t>(centroidIndex)) {
+
+				counts.sharedTriangles += triangleCount;
+				counts.sharedEdges += edgeCount;
+
+			}
+
+		}
+
+	}
+
+	//Stored one entry up, the prefix sum turns it into the offsets of the next cell
+	m_cellMeshOffsets[centroidIndex + 1] = counts;
+
+}
+
+//Write the triangles and edges of a cell at its offsets in the render lists
+//Back culled triangles wind clockwise seen from outside the cell - the face loops run counter-clockwise
+void VoronoiDiagram::ConstructCellMesh(uint32_t centroidIndex) {
+
+	VoronoiCellView cell = m_voronoiCells.GetCell(centroidIndex);
+	const Point& centroid = m_centroids[centroidIndex];
+	const CellMeshOffsets& offsets = m_cellMeshOffsets[centroidIndex];
+	const CellMeshOffsets& listSizes = m_cellMeshOffsets.back();
+
+	uint32_t cellTriangle = offsets.cellTriangles;
+	uint32_t sharedTriangle = offsets.sharedTriangles;
+	uint32_t sharedEdge = offsets.sharedEdges;
+	uint32_t unitCubeTriangle = listSizes.sharedTriangles + offsets.unitCubeTriangles;
+	uint32_t unitCubeEdge = listSizes.sharedEdges + offsets.unitCubeEdges;
+	uint32_t interiorBackCulledTriangle = offsets.interiorTriangles;
+	uint32_t unitCubeBackCulledTriangle = listSizes.interiorTriangles + offsets.unitCubeTriangles;
+
+	//Sienna Brown
+	Point renderedCubeColor(160.0f / 255.0f, 82.0f / 255.0f, 45.0f / 255.0f);
+	Point whiteEdgeColor(1.0f, 1.0f, 1.0f);
+
+	for (uint32_t f = 0; f < cell.GetFaceCount(); ++f) {
+
+		int32_t faceNeighbor = cell.faceNeighbors[f];
+		bool isUnitCubeFace = VoronoiCellBuilder::IsUnitCubeFace(faceNeighbor);
+		bool isSharedFace = !isUnitCubeFace && faceNeighbor > static_cast<int32_t>(centroidIndex);
+
+		uint32_t first = cell.faceOffsets[f];
+		uint32_t last = cell.faceOffsets[f + 1];
+		const Point& faceOrigin = cell.vertices[cell.faceVertices[first]];
+		Point color = this->GetFaceColor(centroidIndex, faceNeighbor);
+		Point faceNormal = this->GetFaceNormal(centroidIndex, faceNeighbor);
+
+		//Face normal pointing away from the unit cube center
+		Point cubeFaceNormal = faceNormal;
+		if (Dot(Subtract(Point(0.5f, 0.5f, 0.5f), faceOrigin), cubeFaceNormal) >= 0.0f) cubeFaceNormal *= -1.0f;
+
+		for (uint32_t k = first + 2; k < last; ++k) {
+
+			const Point& b = cell.vertices[cell.faceVertices[k - 1]];
+			const Point& c = cell.vertices[cell.faceVertices[k]];
+
+			m_clippedVoronoiCellsTriangles[cellTriangle++] = ColorTriangle(faceOrigin, b, c, color);
+
+			if (isSharedFace) {
+
+				m_clippedVoronoiTriangles[sharedTriangle] = ColorTriangle(faceOrigin, b, c, color);
+				m_clippedVoronoiTrianglesFaceNormals[sharedTriangle++] = NormalColorTriangle(faceOrigin, b, c, renderedCubeColor, cubeFaceNormal);
+
+			}
+			else if (isUnitCubeFace) {
+
+				m_clippedVoronoiTrianglesFaceNormals[unitCubeTriangle++] = NormalColorTriangle(faceOrigin, b, c, renderedCubeColor, cubeFaceNormal);
+
+			}
+
+			uint32_t backCulledTriangle = isUnitCubeFace ? unitCubeBackCulledTriangle++ : interiorBackCulledTriangle++;
+			m_clippedVoronoiCellsBackCulledTriangles[backCulledTriangle] = ColorTriangle(faceOrigin, c, b, centroid);
+			m_clippedVoronoiCellsBackCulledTrianglesNormals[backCulledTriangle] = NormalColorTriangle(faceOrigin, c, b, centroid, faceNormal);
+
+		}
+
+		//Voronoi edges that lie on the unit cube
+		if (isSharedFace || isUnitCubeFace) {
+
+			uint32_t& edge = isSharedFace ? sharedEdge : unitCubeEdge;
+			for (uint32_t k = first + 1; k < last; ++k) {
+
+				m_voronoiEdgesUnitCube[edge++] = ColorEdge(cell.vertices[cell.faceVertices[k - 1]], cell.vertices[cell.faceVertices[k]], whiteEdgeColor);
+
+			}
+			m_voronoiEdgesUnitCube[edge++] = ColorEdge(cell.vertices[cell.faceVertices[last - 1]], faceOrigin, whiteEdgeColor);
+
+		}
+
+	}
+
+}
+
+//Index of the delaunay edge between two centroids, the edge count when they are not connected
+uint32_t VoronoiDiagram::FindDelaunayEdge(uint32_t centroidA, uint32_t centroidB) const {
+
+	uint32_t first = centroidA < centroidB ? centroidA : centroidB;
+	uint32_t second = centroidA < centroidB ? centroidB : centroidA;
+
+	for (uint32_t i = m_delaunayEdgeOffsets[first]; i < m_delaunayEdgeOffsets[first + 1]; ++i) {
+
+		if (m_delaunayEdgesIndex[i].b == second) return i;
+
+	}
+
+	return static_cast<uint32_t>(m_delaunayEdgesIndex.size());
+
+}
+
+//Faces between cells share the color of their delaunay edge, the faces on the unit cube have a color per cell
+Point VoronoiDiagram::GetFaceColor(uint32_t centroidIndex, int32_t faceNeighbor) const {
+
+	if (VoronoiCellBuilder::IsUnitCubeFace(faceNeighbor)) {
+
+		return m_unitCubeFaceColors[centroidIndex * VoronoiCellBuilder::UNIT_CUBE_FACE_COUNT + VoronoiCellBuilder::GetUnitCubeFace(faceNeighbor)];
+
+	}
+
+	uint32_t delaunayEdge = this->FindDelaunayEdge(centroidIndex, static_cast<uint32_t>(faceNeighbor));
+	return delaunayEdge < m_delaunayEdgeColors.size() ? m_delaunayEdgeColors[delaunayEdge] : Point();
+
+}
+
+//Unit normal of a cell face pointing out of the cell
+Point VoronoiDiagram::GetFaceNormal(uint32_t centroidIndex, int32_t faceNeighbor) const {
+
+	if (VoronoiCellBuilder::IsUnitCubeFace(faceNeighbor)) return VoronoiCellBuilder::GetUnitCubeFaceNormal(VoronoiCellBuilder::GetUnitCubeFace(faceNeighbor));
+
+	return Normalize(Subtract(m_centroids[faceNeighbor], m_centroids[centroidIndex]));
+
+}
+
+//Circumcenter from the edges at a - a + (|u|^2 (v x w) + |v|^2 (w x u) + |w|^2 (u x v)) / (2 u . (v x w)) - in double, the edges of the
+//thin tetrahedrons around nearly coplanar centroids lose too much to cancellation in float
+void VoronoiDiagram::CalculateCircumsphere(Tetrahedron* tetrahedron) {
+
+	const Point& a = tetrahedron->a;
+	double u[3] = { static_cast<double>(tetrahedron->b.x) - a.x, static_cast<double>(tetrahedron->b.y) - a.y, static_cast<double>(tetrahedron->b.z) - a.z };
+	double v[3] = { static_cast<double>(tetrahedron->c.x) - a.x, static_cast<double>(tetrahedron->c.y) - a.y, static_cast<double>(tetrahedron->c.z) - a.z };
+	double w[3] = { static_cast<double>(tetrahedron->d.x) - a.x, static_cast<double>(tetrahedron->d.y) - a.y, static_cast<double>(tetrahedron->d.z) - a.z };
+
+	double vw[3] = { v[1] * w[2] - v[2] * w[1], v[2] * w[0] - v[0] * w[2], v[0] * w[1] - v[1] * w[0] };
+	double wu[3] = { w[1] * u[2] - w[2] * u[1], w[2] * u[0] - w[0] * u[2], w[0] * u[1] - w[1] * u[0] };
+	double uv[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+
+	double uSq = u[0] * u[0] + u[1] * u[1] + u[2] * u[2];
+	double vSq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+	double wSq = w[0] * w[0] + w[1] * w[1] + w[2] * w[2];
+	double denominator = 2.0 * (u[0] * vw[0] + u[1] * vw[1] + u[2] * vw[2]);
+
+	double offset[3];
+	for (uint32_t i = 0; i < 3; ++i) offset[i] = (uSq * vw[i] + vSq * wu[i] + wSq * uv[i]) / denominator;
+
+	tetrahedron->circumcenter = Point(static_cast<float>(a.x + offset[0]), static_cast<float>(a.y + offset[1]), static_cast<float>(a.z + offset[2]));
+	tetrahedron->circumradius = static_cast<float>(std::sqrt(offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2]));
+
+}
+
+}
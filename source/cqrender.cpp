@@ -732,8 +732,9 @@ void CQRender::OnSpace() {
 
 }
 
-CQRender::CQRender(Microsoft::WRL::ComPtr<ID3D12Device2> dxDevice, std::shared_ptr<CommandQueue> copyCQ, std::shared_ptr<CommandQueue> directCQ) 
-	: m_dxDevice(dxDevice), m_copyCQ(copyCQ), m_directCQ(directCQ), m_isLoaded(FALSE), m_sampleResourceWidth(0) {
+CQRender::CQRender(Microsoft::WRL::ComPtr<ID3D12Device2> dxDevice, std::shared_ptr<CommandQueue> copyCQ, std::shared_ptr<CommandQueue> directCQ, UINT centroidCount) 
+	: m_dxDevice(dxDevice), m_copyCQ(copyCQ), m_directCQ(directCQ), m_isLoaded(FALSE), m_sampleResourceWidth(0), m_centroidCount(centroidCount),
+	m_clearCentroidBuffer(centroidCount), m_readbackCentroidBuffer(centroidCount), m_initialCentroidColors(centroidCount) {
 
 	m_pixelVBView = { 0 };
 	m_colorVBView = { 0 };
@@ -750,6 +751,11 @@ CQRender::CQRender(Microsoft::WRL::ComPtr<ID3D12Device2> dxDevice, std::shared_p
 	std::srand(static_cast<UINT>(std::time(nullptr)));
 
 	m_resolver = std::make_unique<Resolver>(INPUT_VIDEO_FILE_PATH);
+	m_kmeansSeeder = std::make_unique<VoronoiCore::KMeansSeeder>(static_cast<uint64_t>(std::time(nullptr)), nullptr);
+
+	//Only the centroid shift is read back from the GPU
+	VoronoiCore::ConvergenceTolerance convergenceTolerance = { COMPUTE_SHADER_KC_CONVERGENCE_CENTROID_SHIFT, 0.0f, 0.0f, COMPUTE_SHADER_KC_LOOP_COUNT };
+	m_convergenceMonitor = std::make_unique<VoronoiCore::ConvergenceMonitor>(convergenceTolerance);
 
 	const DirectX::XMVECTOR eyePosition = DirectX::XMVectorSet(0.0f, 0.0f, -2.7f, 1.0f);
 	const DirectX::XMVECTOR focusPosition = DirectX::XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f);
@@ -789,7 +795,7 @@ void CQRender::LoadShaders() {
 	char centroidCountBuffer[8] = {};
 	char textureWidthBuffer[8] = {};
 	char textureHeightBuffer[8] = {};
-	sprintf_s(centroidCountBuffer, 8, "%d", COMPUTE_SHADER_KC_CENTROID_COUNT);
+	sprintf_s(centroidCountBuffer, 8, "%u", m_centroidCount);
 	sprintf_s(textureWidthBuffer, 8, "%d", 1280);
 	sprintf_s(textureHeightBuffer, 8, "%d", 720);
 	D3D_SHADER_MACRO shaderMacros[4] = {};
@@ -1649,7 +1655,7 @@ void CQRender::InitCSKC1Resources(UINT64 inputWidth, UINT64 inputHeight) {
 	D3D12_RESOURCE_DESC centroidBufferResourceDescription = {};
 	centroidBufferResourceDescription.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
 	centroidBufferResourceDescription.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
-	centroidBufferResourceDescription.Width = COMPUTE_SHADER_KC_CENTROID_COUNT * sizeof(Centroid);
+	centroidBufferResourceDescription.Width = m_centroidCount * sizeof(Centroid);
 	centroidBufferResourceDescription.Height = 1;
 	centroidBufferResourceDescription.DepthOrArraySize = 1;
 	centroidBufferResourceDescription.MipLevels = 1;
@@ -1670,7 +1676,7 @@ void CQRender::InitCSKC1Resources(UINT64 inputWidth, UINT64 inputHeight) {
 	D3D12_RESOURCE_DESC centroidCopyBufferResourceDescription = {};
 	centroidCopyBufferResourceDescription.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
 	centroidCopyBufferResourceDescription.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
-	centroidCopyBufferResourceDescription.Width = COMPUTE_SHADER_KC_CENTROID_COUNT * sizeof(Centroid);
+	centroidCopyBufferResourceDescription.Width = m_centroidCount * sizeof(Centroid);
 	centroidCopyBufferResourceDescription.Height = 1;
 	centroidCopyBufferResourceDescription.DepthOrArraySize = 1;
 	centroidCopyBufferResourceDescription.MipLevels = 1;
@@ -1691,7 +1697,7 @@ void CQRender::InitCSKC1Resources(UINT64 inputWidth, UINT64 inputHeight) {
 	D3D12_RESOURCE_DESC centroidReadbackBufferResourceDescription = {};
 	centroidReadbackBufferResourceDescription.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
 	centroidReadbackBufferResourceDescription.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
-	centroidReadbackBufferResourceDescription.Width = COMPUTE_SHADER_KC_CENTROID_COUNT * sizeof(Centroid);
+	centroidReadbackBufferResourceDescription.Width = m_centroidCount * sizeof(Centroid);
 	centroidReadbackBufferResourceDescription.Height = 1;
 	centroidReadbackBufferResourceDescription.DepthOrArraySize = 1;
 	centroidReadbackBufferResourceDescription.MipLevels = 1;
@@ -1727,7 +1733,7 @@ void CQRender::InitCSKC1Resources(UINT64 inputWidth, UINT64 inputHeight) {
 	centroidBufferUAVDescription.Format = DXGI_FORMAT_UNKNOWN;
 	centroidBufferUAVDescription.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
 	centroidBufferUAVDescription.Buffer.FirstElement = 0;
-	centroidBufferUAVDescription.Buffer.NumElements = COMPUTE_SHADER_KC_CENTROID_COUNT;
+	centroidBufferUAVDescription.Buffer.NumElements = m_centroidCount;
 	centroidBufferUAVDescription.Buffer.StructureByteStride = sizeof(Centroid);
 	centroidBufferUAVDescription.Buffer.CounterOffsetInBytes = 0;
 	centroidBufferUAVDescription.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_NONE;
@@ -1965,8 +1971,8 @@ void CQRender::InitCentroidBuffer() {
 	//Initial centroid position/color
 
 	FLOAT randomNumber = 0.0f;
-	randomNumber = 1.0f / static_cast<FLOAT>(COMPUTE_SHADER_KC_CENTROID_COUNT);
-	for (UINT i = 0; i < COMPUTE_SHADER_KC_CENTROID_COUNT; ++i) {
+	randomNumber = 1.0f / static_cast<FLOAT>(m_centroidCount);
+	for (UINT i = 0; i < m_centroidCount; ++i) {
 
 		if (COMPUTE_SHADER_KC_CENTROID_INIT_FULL_RANDOM) {
 
@@ -1985,9 +1991,9 @@ void CQRender::InitCentroidBuffer() {
 		}
 		else if (COMPUTE_SHADER_KC_CENTROID_INIT_FROM_PIXEL_SET) {
 
-			m_clearCentroidBuffer[i].color[0] = m_initialCentroidColors[i][0];
-			m_clearCentroidBuffer[i].color[1] = m_initialCentroidColors[i][1];
-			m_clearCentroidBuffer[i].color[2] = m_initialCentroidColors[i][2];
+			m_clearCentroidBuffer[i].color[0] = m_initialCentroidColors[i].x;
+			m_clearCentroidBuffer[i].color[1] = m_initialCentroidColors[i].y;
+			m_clearCentroidBuffer[i].color[2] = m_initialCentroidColors[i].z;
 
 		}
 		
@@ -1995,11 +2001,11 @@ void CQRender::InitCentroidBuffer() {
 
 	//Copy into copy buffer
 	BYTE* centroidCopyBufferBits = nullptr;
-	SIZE_T copySize = SIZE_T(COMPUTE_SHADER_KC_CENTROID_COUNT * sizeof(Centroid));
+	SIZE_T copySize = SIZE_T(m_centroidCount * sizeof(Centroid));
 	D3D12_RANGE writeRange = {0, copySize };
 	D3D12_RANGE readRange = {0, 0};
 	ThrowIfFailed(m_cskc1CentroidCopyBuffer->Map(0, &readRange, reinterpret_cast<void**>(&centroidCopyBufferBits)));
-	::memcpy(centroidCopyBufferBits, &m_clearCentroidBuffer[0], copySize);
+	::memcpy(centroidCopyBufferBits, m_clearCentroidBuffer.data(), copySize);
 	m_cskc1CentroidCopyBuffer->Unmap(0, &writeRange);
 
 	//Copy into centroid buffer
@@ -2040,7 +2046,7 @@ void CQRender::ReadbackCentroidBuffer() {
 
 	mWRL::ComPtr<ID3D12GraphicsCommandList> commandList = m_copyCQ->GetCommandList();
 
-	SIZE_T bufferSize = COMPUTE_SHADER_KC_CENTROID_COUNT * sizeof(Centroid);
+	SIZE_T bufferSize = m_centroidCount * sizeof(Centroid);
 	commandList->CopyBufferRegion(m_cskc1CentroidReadbackBuffer.Get(), 0, m_cskc1CentroidBuffer.Get(), 0, UINT64(bufferSize));
 	m_copyCQ->WaitForFenceValue(m_copyCQ->ExecuteCommandList(commandList));
 
@@ -2049,7 +2055,7 @@ void CQRender::ReadbackCentroidBuffer() {
 	D3D12_RANGE writeRange = {0, 0};
 	ThrowIfFailed(m_cskc1CentroidReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&centroidReadbackBufferBits)));
 
-	::memcpy(m_readbackCentroidBuffer, centroidReadbackBufferBits, bufferSize);
+	::memcpy(m_readbackCentroidBuffer.data(), centroidReadbackBufferBits, bufferSize);
 
 	m_cskc1CentroidReadbackBuffer->Unmap(0, &writeRange);
 
@@ -2102,7 +2108,7 @@ void CQRender::InitTextureBuffer() {
 
 }
 
-//Initialize kc1 compute shader centroid colors
+//Initialize kc1 compute shader centroid colors with k-means++ seeding over the pixels of the sample
 void CQRender::InitCentroidColors(IMFSample* sample) {
 
 	IMFMediaBuffer* mediaBuffer = nullptr;
@@ -2115,34 +2121,9 @@ void CQRender::InitCentroidColors(IMFSample* sample) {
 	ThrowIfFailed(mediaBuffer->Lock(&mediaBufferBits, &mediaBufferMaxLength, &mediaBufferCurrentLength));
 
 	DWORD pixelCount = mediaBufferCurrentLength / 4;
-	DWORD* mediaBufferBitsDWORD = (DWORD*)mediaBufferBits;
-	DWORD randomNumberColors = 0;
-	UINT randomNumber = 0;
-	UINT8 uintColorR = 0;
-	UINT8 uintColorG = 0;
-	UINT8 uintColorB = 0;
-	FLOAT floatColorR = 0.0f;
-	FLOAT floatColorG = 0.0f;
-	FLOAT floatColorB = 0.0f;
-
-	for (UINT i = 0; i < COMPUTE_SHADER_KC_CENTROID_COUNT; ++i) {
-
-		randomNumber = std::rand() % pixelCount;
-		randomNumberColors = *(mediaBufferBitsDWORD + randomNumber);
-
-		uintColorR = static_cast<UINT8>((randomNumberColors & 0b00000000111111110000000000000000) >> 16);
-		uintColorG = static_cast<UINT8>((randomNumberColors & 0b00000000000000001111111100000000) >> 8);
-		uintColorB = static_cast<UINT8>(randomNumberColors & 0b00000000000000000000000011111111);
-
-		floatColorR = static_cast<FLOAT>(uintColorR) / 255.0f;
-		floatColorG = static_cast<FLOAT>(uintColorG) / 255.0f;
-		floatColorB = static_cast<FLOAT>(uintColorB) / 255.0f;
+	const UINT32* pixels = reinterpret_cast<const UINT32*>(mediaBufferBits);
 
-		m_initialCentroidColors[i][0] = floatColorR;
-		m_initialCentroidColors[i][1] = floatColorG;
-		m_initialCentroidColors[i][2] = floatColorB;
-
-	}
+	m_kmeansSeeder->Seed(VoronoiCore::SEEDING_METHOD_KMEANS_PLUS_PLUS, pixels, nullptr, pixelCount, m_centroidCount, m_initialCentroidColors.data());
 
 	ThrowIfFailed(mediaBuffer->Unlock());
 	SafeRelease(&mediaBuffer);
@@ -2275,6 +2256,17 @@ void CQRender::CSKC1() {
 	D3D12_GPU_DESCRIPTOR_HANDLE cskc3FirstDescriptorHandle = m_cskc1SRVDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
 	cskc3FirstDescriptorHandle.ptr = SIZE_T(UINT64(cskc3FirstDescriptorHandle.ptr) + UINT64(descriptorHandleIncrementSize));
 
+	//Centroid colors before the iteration, to measure how far the iteration moved them
+	std::vector<VoronoiCore::Point> previousCentroidColors(m_centroidCount);
+	for (UINT j = 0; j < m_centroidCount; ++j) {
+
+		previousCentroidColors[j].x = m_clearCentroidBuffer[j].color[0];
+		previousCentroidColors[j].y = m_clearCentroidBuffer[j].color[1];
+		previousCentroidColors[j].z = m_clearCentroidBuffer[j].color[2];
+
+	}
+
+	m_convergenceMonitor->Reset();
 
 	for (UINT i = 0; i < COMPUTE_SHADER_KC_LOOP_COUNT; ++i) {
 
@@ -2296,7 +2288,7 @@ void CQRender::CSKC1() {
 		ReadbackCentroidBuffer();
 
 		UINT64 pixelCount = 0;
-		for (UINT j = 0; j < COMPUTE_SHADER_KC_CENTROID_COUNT; ++j) pixelCount += m_readbackCentroidBuffer[j].count;
+		for (UINT j = 0; j < m_centroidCount; ++j) pixelCount += m_readbackCentroidBuffer[j].count;
 
 		FLOAT uintSumToFloat[3] = { 
 		
@@ -2313,14 +2305,39 @@ void CQRender::CSKC1() {
 		commandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
 		commandList->SetComputeRootDescriptorTable(0, cskc3FirstDescriptorHandle);
 
-		commandList->Dispatch(COMPUTE_SHADER_KC_CENTROID_COUNT, 1, 1);
+		commandList->Dispatch(m_centroidCount, 1, 1);
 
 		m_directCQ->WaitForFenceValue(m_directCQ->ExecuteCommandList(commandList));
 
 		ReadbackCentroidBuffer();
 
+		//Stop once the centroids no longer move
+		VoronoiCore::IterationStatistics statistics = { 0.0f, -1.0f, -1.0, 0 };
+		for (UINT j = 0; j < m_centroidCount; ++j) {
+
+			FLOAT shiftR = m_readbackCentroidBuffer[j].color[0] - previousCentroidColors[j].x;
+			FLOAT shiftG = m_readbackCentroidBuffer[j].color[1] - previousCentroidColors[j].y;
+			FLOAT shiftB = m_readbackCentroidBuffer[j].color[2] - previousCentroidColors[j].z;
+			FLOAT shift = sqrtf(shiftR * shiftR + shiftG * shiftG + shiftB * shiftB);
+			if (shift > statistics.maxCentroidShift) statistics.maxCentroidShift = shift;
+
+			previousCentroidColors[j].x = m_readbackCentroidBuffer[j].color[0];
+			previousCentroidColors[j].y = m_readbackCentroidBuffer[j].color[1];
+			previousCentroidColors[j].z = m_readbackCentroidBuffer[j].color[2];
+
+		}
+
+		m_convergenceMonitor->AddIteration(statistics);
+		if (m_convergenceMonitor->IsFinished()) break;
+
 	}
 
+	char reportBuffer[128];
+	sprintf_s(reportBuffer, sizeof(reportBuffer), "k-means compute shader: %u passes, average %.2f passes over %llu frames\n",
+		m_convergenceMonitor->GetIterationCount(), m_convergenceMonitor->GetAverageIterationCount(),
+		static_cast<unsigned long long>(m_convergenceMonitor->GetFinishedFrameCount()));
+	OutputDebugStringA(reportBuffer);
+
 	mWRL::ComPtr<ID3D12GraphicsCommandList> commandList = m_directCQ->GetCommandList();
 
 	//Set texture buffer state to D3D12_RESOURCE_STATE_UNORDERED_ACCESS 
@@ -4,8 +4,8 @@
 #include <DirectXMath.h>
 #include <wrl.h>
 
+#include <future>
 #include <memory>
-#include <thread>
 #include <vector>
 
 #include <IRender.h>
@@ -16,11 +16,21 @@
 #include <pipelinestate.h>
 #include <config.h>
 
+#include <color_histogram.h>
+#include <color_space.h>
+#include <kmeans_convergence.h>
+#include <kmeans.h>
+#include <palette_sizer.h>
+#include <scene_cut_detector.h>
+#include <task_scheduler.h>
+#include <voronoi_diagram.h>
+
 class CIterationsRender : public IRender {
 
 public:
 
-	CIterationsRender(Microsoft::WRL::ComPtr<ID3D12Device2> device, std::shared_ptr<CommandQueue> copyCQ, std::shared_ptr<CommandQueue> directCQ);
+	CIterationsRender(Microsoft::WRL::ComPtr<ID3D12Device2> device, std::shared_ptr<CommandQueue> copyCQ, std::shared_ptr<CommandQueue> directCQ,
+		UINT centroidCount = COMPUTE_SHADER_KC_CENTROID_COUNT);
 	~CIterationsRender();
 	void LoadContent(double* updateFPS, D3D12_RESOURCE_DESC backBufferDescription);
 	BOOL OnRender(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>, Microsoft::WRL::ComPtr<ID3D12Resource>, D3D12_CPU_DESCRIPTOR_HANDLE);
@@ -31,214 +41,6 @@ public:
 
 private:
 
-	struct Point {
-
-	public:
-
-		FLOAT x;
-		FLOAT y;
-		FLOAT z;
-
-		Point(FLOAT x, FLOAT y, FLOAT z) : x(x), y(y), z(z) {}
-		Point() : x(0.0f), y(0.0f), z(0.0f) {}
-		Point(const Point& point) {
-
-			x = point.x;
-			y = point.y;
-			z = point.z;
-
-		}
-		Point& operator=(const Point& point) {
-
-			x = point.x;
-			y = point.y;
-			z = point.z;
-
-			return *this;
-
-		}
-
-		BOOL operator==(const Point& point) {
-
-			if (abs(x - point.x) >= 0.000000100f) return FALSE;
-			if (abs(y - point.y) >= 0.000000100f) return FALSE;
-			if (abs(z - point.z) >= 0.000000100f) return FALSE;
-			return TRUE;
-
-		}
-
-		Point& operator*=(const float& scalar) {
-
-			this->x *= scalar;
-			this->y *= scalar;
-			this->z *= scalar;
-
-			return *this;
-
-		}
-
-		Point& operator-=(const float& scalar) {
-
-			this->x -= scalar;
-			this->y -= scalar;
-			this->z -= scalar;
-
-			return *this;
-
-		}
-		Point& operator-=(const Point& point) {
-
-			this->x -= point.x;
-			this->y -= point.y;
-			this->z -= point.z;
-
-			return *this;
-
-		}
-
-		Point& operator+=(const float& scalar) {
-
-			this->x += scalar;
-			this->y += scalar;
-			this->z += scalar;
-
-			return *this;
-
-		}
-		Point& operator+=(const Point& point) {
-
-			this->x += point.x;
-			this->y += point.y;
-			this->z += point.z;
-
-			return *this;
-
-		}
-
-	};
-
-	struct Edge {
-
-		Point a;
-		Point b;
-
-		Edge(Point a, Point b) : a(a), b(b) {}
-		Edge() : a(Point()), b(Point()) {}
-		Edge(const Edge& edge) {
-
-			a = edge.a;
-			b = edge.b;
-
-		}
-		Edge& operator=(const Edge& edge) {
-
-			a = edge.a;
-			b = edge.b;
-
-			return *this;
-
-		}
-
-		BOOL operator==(const Edge& edge) {
-
-			if (a == edge.a && b == edge.b) return TRUE;
-			if (a == edge.b && b == edge.a) return TRUE;
-			return FALSE;
-		}
-
-	};
-
-	struct Triangle {
-
-	public:
-
-		Point a;
-		Point b;
-		Point c;
-
-		Triangle(Point a, Point b, Point c) : a(a), b(b), c(c) {}
-		Triangle() : a(Point()), b(Point()), c(Point()) {}
-		BOOL operator==(const Triangle& triangle) {
-
-			if (a == triangle.a && b == triangle.b && c == triangle.c) return TRUE;
-			if (a == triangle.a && b == triangle.c && c == triangle.b) return TRUE;
-			if (a == triangle.b && b == triangle.a && c == triangle.c) return TRUE;
-			if (a == triangle.b && b == triangle.c && c == triangle.a) return TRUE;
-			if (a == triangle.c && b == triangle.b && c == triangle.a) return TRUE;
-			if (a == triangle.c && b == triangle.a && c == triangle.b) return TRUE;
-			return FALSE;
-
-		}
-
-	};
-
-	struct VoronoiEdge : Edge {
-
-		Triangle triangle;
-
-		VoronoiEdge(Point a, Point b) : Edge(a, b), triangle(Triangle()) {}
-
-	};
-
-	struct ColorEdge : Edge {
-
-		Point color;
-
-		ColorEdge(Point a, Point b, Point color) : Edge(a, b), color(color) {}
-
-	};
-
-	struct ColorTriangle : Triangle {
-
-		Point color;
-
-		ColorTriangle(Point a, Point b, Point c, Point color) : Triangle(a, b, c), color(color) {}
-
-	};
-
-	struct NormalColorTriangle : ColorTriangle {
-
-		Point normal;
-
-		NormalColorTriangle(Point a, Point b, Point c, Point color, Point normal) : ColorTriangle(a, b, c, color), normal(normal) {}
-
-	};
-
-	struct Tetrahedron {
-
-		Point a;
-		Point b;
-		Point c;
-		Point d;
-		Point circumcenter;
-		FLOAT circumradius;
-
-	};
-
-	struct EdgeIndex {
-
-		UINT a;
-		UINT b;
-
-		EdgeIndex() : a(0), b(0) {}
-		EdgeIndex(UINT a, UINT b) : a(a), b(b) {}
-
-	};
-
-	struct Plane {
-
-		FLOAT xCoef;
-		FLOAT yCoef;
-		FLOAT zCoef;
-		FLOAT kCoef;
-
-		Plane(FLOAT xCoef, FLOAT yCoef, FLOAT zCoef, FLOAT kCoef) : xCoef(xCoef), yCoef(yCoef), zCoef(zCoef), kCoef(kCoef) {}
-		Plane() : xCoef(0.0f), yCoef(0.0f), zCoef(0.0f), kCoef(0.0f) {}
-
-	};
-
-	typedef Plane PlaneNORMAL;
-
 	//K-means clustering and voronoi diagram
 
 	void ResetCentroids();
@@ -248,11 +50,7 @@ private:
 
 	void ClusterAndVoronoi();
 
-	void CalculateCircumsphere(UINT i);
-	void CalculateCircumsphere(Tetrahedron* tetrahedron);
-	BOOL IsFace(Point* a, Point* b, Point* c, Tetrahedron* tetrahedron);
-	BOOL IsEdge(Point* a, Point* b, Tetrahedron* tetrahedron);
-	BOOL LinePlaneIntersection(Point* lineA, Point* lineB, FLOAT planeXCoef, FLOAT planeYCoef, FLOAT planeZCoef, FLOAT planeKCoef, Point* intersection);
+	void ReportConvergence();
 
 	//DirectX
 
@@ -261,7 +59,7 @@ private:
 	void InitVertexBufferPointListPixelPosition();
 	void UploadVertexBufferPointListPixelPosition();
 
-	void InitVertexBufferTriangleListVoronoiDiagram();
+	void InitVertexBufferTriangleListVoronoiDiagram(UINT triangleCapacity);
 	void UploadVertexBufferTriangleListVoronoiDiagram();
 
 	void InitRootSignatureNoLighting();
@@ -294,67 +92,22 @@ private:
 
 
 
-	std::thread m_clusterAndVoronoiThread;
-
-	Point m_centroids[COMPUTE_SHADER_KC_CENTROID_COUNT];
-
-	std::vector<Tetrahedron> m_triangulation = {};
-	std::vector<Tetrahedron*> m_badTriangulation = {};
-	std::vector<UINT> m_badTriangulationIndex = {};
-	std::vector<Triangle> m_polyhedron = {};
-
-	std::vector<Edge> m_delaunayEdges = {};
-	std::vector<EdgeIndex> m_delaunayEdgesIndex = {};
-	std::vector<Tetrahedron> m_centroidTetrahedrons = {};
-
-	std::vector<Point> m_voronoiVertices = {};
-	std::vector<VoronoiEdge> m_voronoiEdges = {};
-	std::vector<Edge> m_voronoiFace = {};
-	std::vector<Edge> m_voronoiFaceOrdered = {};
-	std::vector<ColorEdge> m_voronoiColoredEdges = {};
-	std::vector<ColorTriangle> m_voronoiColoredTriangles = {};
-	std::vector<Edge> m_voronoiFaces = {};
-	std::vector<UINT> m_voronoiFacesCount = {};
-
-	std::vector<std::vector<Edge>> m_voronoiCells[COMPUTE_SHADER_KC_CENTROID_COUNT] = {};
-	std::vector<std::vector<Edge>> m_separateVoronoiFaces = {};
-	std::vector<UINT> m_pointedVoronoiCells[COMPUTE_SHADER_KC_CENTROID_COUNT] = {};
-	std::vector<Plane> m_separateVoronoiFacePlanes = {};
-	std::vector<Point> m_separateVoronoiFaceColors = {};
-
-	std::vector<Point> m_cubeCrossSection = {};
-	std::vector<FLOAT> m_cubeCrossSectionCentroidAngle = {};
-	std::vector<Point> m_cubeCrossSectionOrdered = {};
-	std::vector<std::vector<Point>> m_separateVoronoiFacesCulledOrdered = {};
-
-	std::vector<Edge> m_unitCubeEdges = {};
-	std::vector<Point> m_unitCubeVertices = {};
-	std::vector<ColorTriangle> m_clippedVoronoiTriangles = {};
-
-	std::vector<UINT> m_culledVoronoiFacesIndex = {};
-	std::vector<ColorTriangle> m_clippedVoronoiCellsTriangles = {};
-
-	std::vector<Point> m_unitCubeFace1Points = {};
-	std::vector<Point> m_unitCubeFace2Points = {};
-	std::vector<Point> m_unitCubeFace3Points = {};
-	std::vector<Point> m_unitCubeFace4Points = {};
-	std::vector<Point> m_unitCubeFace5Points = {};
-	std::vector<Point> m_unitCubeFace6Points = {};
-	std::vector<FLOAT> m_unitCubeFaceCentroidAngle = {};
-	std::vector<Point> m_unitCubeFaceOrdered = {};
-
-	std::vector<PlaneNORMAL> m_separateVoronoiFaceNormals = {};
-	std::vector<NormalColorTriangle> m_clippedVoronoiTrianglesFaceNormals = {};
-
-	std::vector<ColorEdge> m_voronoiEdgesUnitCube = {};
-	std::vector<ColorTriangle> m_clippedVoronoiCellsBackCulledTriangles = {};
-	std::vector<NormalColorTriangle> m_clippedVoronoiCellsBackCulledTrianglesNormals = {};
+	std::unique_ptr<VoronoiCore::TaskScheduler> m_taskScheduler;
+	std::future<void> m_clusterAndVoronoi;
 
-	UINT m_preClipFaceCount = 0;
+	std::unique_ptr<VoronoiCore::ColorSpaceConverter> m_colorSpaceConverter;
+	std::vector<UINT32> m_convertedFrame;
+	std::unique_ptr<VoronoiCore::ColorHistogram> m_colorHistogram;
+	BOOL m_isColorHistogramBuilt = FALSE;
+	std::unique_ptr<VoronoiCore::KMeans> m_kmeans;
+	std::unique_ptr<VoronoiCore::PaletteSizer> m_paletteSizer;
+	std::unique_ptr<VoronoiCore::SceneCutDetector> m_sceneCutDetector;
+	std::unique_ptr<VoronoiCore::VoronoiDiagram> m_voronoiDiagram;
 
 	UINT m_voronoiDiagramTriangleCount = 0;
+	UINT m_voronoiDiagramTriangleCapacity = 0;
 
-	UINT m_kmeansClusteringIteration;
+	std::unique_ptr<VoronoiCore::ConvergenceMonitor> m_convergenceMonitor;
 
 	std::unique_ptr<Resolver> m_resolver;
 
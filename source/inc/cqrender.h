@@ -5,18 +5,23 @@
 
 #include <wrl.h>
 #include <memory>
+#include <vector>
 
 #include <IRender.h>
 #include <commandqueue.h>
 #include <resolver.h>
 #include <config.h>
 
+#include <kmeans_convergence.h>
+#include <kmeans_seeding.h>
+
 class CQRender : public IRender {
 
 
 public:
 
-	CQRender(Microsoft::WRL::ComPtr<ID3D12Device2> dxDevice, std::shared_ptr<CommandQueue> copyCQ, std::shared_ptr<CommandQueue> directCQ);
+	CQRender(Microsoft::WRL::ComPtr<ID3D12Device2> dxDevice, std::shared_ptr<CommandQueue> copyCQ, std::shared_ptr<CommandQueue> directCQ,
+		UINT centroidCount = COMPUTE_SHADER_KC_CENTROID_COUNT);
 	~CQRender();
 	void LoadContent(double* updateFPS, D3D12_RESOURCE_DESC backBufferDescription);
 	BOOL OnRender(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList, Microsoft::WRL::ComPtr<ID3D12Resource> backBuffer, D3D12_CPU_DESCRIPTOR_HANDLE backBufferDescriptor);
@@ -92,9 +97,12 @@ private:
 		DWORD count;
 	};
 
-	Centroid m_clearCentroidBuffer[COMPUTE_SHADER_KC_CENTROID_COUNT] = {};
-	Centroid m_readbackCentroidBuffer[COMPUTE_SHADER_KC_CENTROID_COUNT] = {};
-	FLOAT m_initialCentroidColors[COMPUTE_SHADER_KC_CENTROID_COUNT][3] = {};
+	UINT m_centroidCount;
+	std::vector<Centroid> m_clearCentroidBuffer;
+	std::vector<Centroid> m_readbackCentroidBuffer;
+	std::vector<VoronoiCore::Point> m_initialCentroidColors;
+	std::unique_ptr<VoronoiCore::KMeansSeeder> m_kmeansSeeder;
+	std::unique_ptr<VoronoiCore::ConvergenceMonitor> m_convergenceMonitor;
 
 	void InitPSO();
 	void InitPointPSO();